@@ -0,0 +1,66 @@
+#include "../Sin/simulated_annealing_sin.h"
+#include <chrono>
+
+/******************************************************************//**
+
+   Benchmark: chain steps per second of the Sin problem, one chain at
+   a time (SimulatedAnnealingSin and StaticSimulatedAnnealingSin)
+   versus lane-batched (BatchedSimulatedAnnealing with 4, 8 and 16
+   lanes), at a constant temperature
+
+   The batched loops are only put in SIMD registers when the compiler
+   targets them (e.g. -O3 -mavx2 or -march=native) and sin() and exp()
+   only when it may use its vector math library (-ffast-math with gcc)
+
+***************************************************************************/
+
+template <class Annealer>
+double chainStepsPerSecond(Annealer& annealer, long iterations){
+	annealer.evaluateSolution();
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(long i=0; i<iterations; i++){
+		annealer.step();
+		annealer.coolDown();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return iterations/seconds;
+}
+
+template <int LANES>
+double batchedChainStepsPerSecond(long iterations, uint64_t seed){
+	double startSolutions[LANES];
+	for(int i=0; i<LANES; i++){
+		startSolutions[i] = 30.0;
+	}
+	BatchedSimulatedAnnealing<SinBatchProblem, LANES> annealer(SinBatchProblem(1.0), startSolutions, 0.01, 0, 1, seed);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(long i=0; i<iterations; i++){
+		annealer.step();
+		annealer.coolDown();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "(best lane " << annealer.getBestLane() << ": " << annealer.getBestSolution(annealer.getBestLane()) << ") ";
+	return iterations*(double)LANES/seconds;
+}
+
+int main(int argc, char *argv[]){
+	const uint64_t SEED = 42;
+	const long ITERATIONS = 20000000;
+
+	// alpha 1 keeps the temperature (and so the acceptance rate) constant
+	SimulatedAnnealingSin virtualSin(30.0, 1.0, 0.01, 0, 1, SEED);
+	StaticSimulatedAnnealingSin staticSin(30.0, 1.0, 0.01, 0, 1, SEED);
+	double virtualRate = chainStepsPerSecond(virtualSin, ITERATIONS);
+	double staticRate = chainStepsPerSecond(staticSin, ITERATIONS);
+	std::cout << "virtual: " << virtualRate << " steps/s" << std::endl;
+	std::cout << "static: " << staticRate << " steps/s" << std::endl;
+
+	double rate4 = batchedChainStepsPerSecond<4>(ITERATIONS/4, SEED);
+	std::cout << "batched, 4 lanes: " << rate4 << " steps/s, " << rate4/staticRate << "x static" << std::endl;
+	double rate8 = batchedChainStepsPerSecond<8>(ITERATIONS/8, SEED);
+	std::cout << "batched, 8 lanes: " << rate8 << " steps/s, " << rate8/staticRate << "x static" << std::endl;
+	double rate16 = batchedChainStepsPerSecond<16>(ITERATIONS/16, SEED);
+	std::cout << "batched, 16 lanes: " << rate16 << " steps/s, " << rate16/staticRate << "x static" << std::endl;
+
+	return 0;
+}
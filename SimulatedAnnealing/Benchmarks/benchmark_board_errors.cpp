@@ -0,0 +1,153 @@
+#include "../NQueens/n_queens_board.h"
+#include "../random_engine.h"
+#include <chrono>
+#include <vector>
+
+/******************************************************************//**
+
+   Benchmark: counting the errors of an NQueensBoard, the former
+   layout (a separately allocated bool array per row, every row,
+   column and diagonal scanned square by square) versus the
+   bit-packed board
+
+   Both boards get the same queens: one per row in a random column,
+   so there are column and diagonal errors to count. Prints the time
+   of one count for N = 100, 1 000 and 10 000.
+
+   Links with NQueens/n_queens_board.cpp
+
+***************************************************************************/
+
+//the board as it was stored and counted before it was bit-packed
+class JaggedBoard{
+
+public:
+	JaggedBoard(int n):N(n){
+		board = new bool*[N];
+		for(int h=0; h<N; h++){
+			board[h] = new bool[N];
+			for(int w=0; w<N; w++){
+				board[h][w] = false;
+			}
+		}
+	}
+
+	~JaggedBoard(){
+		for(int h=0; h<N; h++){
+			delete [] board[h];
+		}
+		delete [] board;
+	}
+
+	void setQueen(int h, int w){
+		board[h][w] = true;
+	}
+
+	void unsetQueen(int h, int w){
+		board[h][w] = false;
+	}
+
+	int calcErrors() const{
+		int errors = 0;
+		for(int i=0; i<N; i++){
+			errors += nErrors(nQueensInRow(i));
+			errors += nErrors(nQueensInColumn(i));
+		}
+		for(int i=0; i<N+N-2; i++){
+			errors += nErrors(nQueensInDiagUp(i));
+			errors += nErrors(nQueensInDiagDown(i));
+		}
+		return errors;
+	}
+
+private:
+	int N;
+	bool** board;
+
+	int nQueensInRow(int i) const{
+		int n = 0;
+		for(int w=0; w<N; w++){
+			n += board[i][w];
+		}
+		return n;
+	}
+
+	int nQueensInColumn(int i) const{
+		int n = 0;
+		for(int h=0; h<N; h++){
+			n += board[h][i];
+		}
+		return n;
+	}
+
+	int nQueensInDiagDown(int i) const{
+		int n = 0;
+		int h = i < N ? N-1-i : 0;
+		int w = i < N ? 0 : i-(N-1);
+		for(; w<N && h<N; w++, h++){
+			n += board[h][w];
+		}
+		return n;
+	}
+
+	int nQueensInDiagUp(int i) const{
+		int n = 0;
+		int h = i < N ? i : N-1;
+		int w = i < N ? 0 : i-(N-1);
+		for(; w<N && h>=0; w++, h--){
+			n += board[h][w];
+		}
+		return n;
+	}
+
+	static int nErrors(int nQueens){
+		return nQueens > 1 ? nQueens-1 : 0;
+	}
+
+};
+
+int main(int argc, char *argv[]){
+	const int SIZES[] = {100, 1000, 10000};
+	Xoshiro256 rng(42);
+	for(int i=0; i<3; i++){
+		int n = SIZES[i];
+		int repeats = (int)(200000000.0/((double)n*n)) + 1;
+
+		JaggedBoard jagged(n);
+		NQueensBoard packed(n);
+		for(int h=0; h<n; h++){
+			packed.unsetQueen(h+1, h+1);
+		}
+		std::vector<int> columns(n);
+		for(int h=0; h<n; h++){
+			columns[h] = rng.nextInt(n);
+			jagged.setQueen(h, columns[h]);
+			packed.setQueen(h+1, columns[h]+1);
+		}
+
+		//taking a queen away and putting it back keeps the count from being hoisted out of the loop, 
+		//recountErrors() counts the packed board again instead of using its line counters
+		int jaggedErrors = 0;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for(int r=0; r<repeats; r++){
+			jagged.unsetQueen(0, columns[0]);
+			jagged.setQueen(0, columns[0]);
+			jaggedErrors += jagged.calcErrors();
+		}
+		double jaggedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()/repeats;
+
+		int packedErrors = 0;
+		start = std::chrono::steady_clock::now();
+		for(int r=0; r<repeats; r++){
+			packed.unsetQueen(1, columns[0]+1);
+			packed.setQueen(1, columns[0]+1);
+			packedErrors += packed.recountErrors();
+		}
+		double packedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()/repeats;
+
+		assert(jaggedErrors == packedErrors);
+		std::cout << "N=" << n << " (" << jaggedErrors/repeats << " errors): jagged " << jaggedSeconds*1e6 << " us, packed "
+			<< packedSeconds*1e6 << " us, speedup " << jaggedSeconds/packedSeconds << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,77 @@
+#include "../NQueens/n_queens_board.h"
+#include "../thread_pool.h"
+#include "../random_engine.h"
+#include <chrono>
+#include <vector>
+
+/******************************************************************//**
+
+   Benchmark: counting the errors of a large NQueensBoard on one
+   thread versus on a ThreadPool, and keeping the line counters up to
+   date versus counting the whole board again after every change
+
+   The board gets one queen per row in a random column. Prints the
+   time of a full count on the calling thread and with
+   recountErrors(&pool) (both have to give the same errors), and the
+   time of moving a queen followed by getErrors() for N = 20 000 and
+   50 000. The parallel speedup is bounded by the number of cores.
+
+   Links with NQueens/n_queens_board.cpp
+
+***************************************************************************/
+
+int main(int argc, char *argv[]){
+	const int SIZES[] = {20000, 50000};
+	const int REPEATS = 5;
+	const int MOVES = 1000000;
+	ThreadPool pool;
+	std::cout << pool.size() << " threads" << std::endl;
+	Xoshiro256 rng(42);
+	for(int i=0; i<2; i++){
+		int n = SIZES[i];
+		NQueensBoard board(n);
+		for(int h=0; h<n; h++){
+			board.unsetQueen(h+1, h+1);
+		}
+		std::vector<int> columns(n);
+		for(int h=0; h<n; h++){
+			columns[h] = rng.nextInt(n);
+			board.setQueen(h+1, columns[h]+1);
+		}
+
+		int sequentialErrors = 0;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for(int r=0; r<REPEATS; r++){
+			sequentialErrors = board.recountErrors();
+		}
+		double sequentialSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()/REPEATS;
+
+		int parallelErrors = 0;
+		start = std::chrono::steady_clock::now();
+		for(int r=0; r<REPEATS; r++){
+			parallelErrors = board.recountErrors(&pool);
+		}
+		double parallelSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()/REPEATS;
+		assert(sequentialErrors == parallelErrors);
+
+		//moves the queen of a random row to a random column, the counters follow the four lines 
+		//it leaves and the four it enters
+		double errors = 0;
+		start = std::chrono::steady_clock::now();
+		for(int m=0; m<MOVES; m++){
+			int h = rng.nextInt(n);
+			board.unsetQueen(h+1, columns[h]+1);
+			columns[h] = rng.nextInt(n);
+			board.setQueen(h+1, columns[h]+1);
+			errors += board.getErrors();
+		}
+		double moveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()/MOVES;
+		assert(board.getErrors() == board.recountErrors(&pool));
+
+		std::cout << "N=" << n << " (" << sequentialErrors << " errors): count " << sequentialSeconds*1e3 << " ms, pool "
+			<< parallelSeconds*1e3 << " ms, speedup " << sequentialSeconds/parallelSeconds << ", move+getErrors "
+			<< moveSeconds*1e9 << " ns (" << sequentialSeconds/moveSeconds << " times faster than counting again, "
+			<< errors/MOVES << " errors on average)" << std::endl;
+	}
+	return 0;
+}
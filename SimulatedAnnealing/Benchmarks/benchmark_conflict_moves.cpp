@@ -0,0 +1,51 @@
+#include "../NQueens/simulated_annealing_permutation_nqueens.h"
+#include <chrono>
+
+/******************************************************************//**
+
+   Benchmark: uniform versus conflict-directed moves for N-Queens on
+   a PermutationBoard
+
+   Runs StaticSimulatedAnnealingPermutationNQueens from the same
+   shuffled board with the same seed, with uniformly drawn moves,
+   with moves that start at a queen in conflict, and with those moves
+   and the min-conflicts descent at the end, until no errors are left
+   (or a minute has passed), and prints the iterations and seconds.
+
+   Links with NQueens/permutation_board.cpp
+
+***************************************************************************/
+
+void run(const char* name, const PermutationBoard& startSolution, bool conflictMoves, double polishTemp){
+	const double MAX_SECONDS = 60;
+	int n = startSolution.getSize();
+	StaticSimulatedAnnealingPermutationNQueens<> annealer(startSolution, 0, 1, 1, 1 - 1.0/n, 42);
+	annealer.setConflictMoves(conflictMoves);
+	annealer.setPolishTemp(polishTemp);
+	annealer.evaluateSolution();
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	double seconds = 0;
+	while(!annealer.reachedPrecision() && seconds < MAX_SECONDS){
+		annealer.step();
+		annealer.coolDown();
+		if((annealer.getIteration() & 0xFFFF) == 0){
+			seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+	}
+	seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "N=" << n << " " << name << ": " << annealer.getDistance() << " errors left after "
+		<< annealer.getIteration() << " iterations, " << seconds << "s" << std::endl;
+}
+
+int main(int argc, char *argv[]){
+	const int SIZES[] = {10000, 100000, 1000000};
+	for(int i=0; i<3; i++){
+		Xoshiro256 rng(7);
+		PermutationBoard startSolution(SIZES[i]);
+		startSolution.shuffle(rng);
+		run("uniform", startSolution, false, 0);
+		run("conflict", startSolution, true, 0);
+		run("conflict+polish", startSolution, true, 0.1);
+	}
+	return 0;
+}
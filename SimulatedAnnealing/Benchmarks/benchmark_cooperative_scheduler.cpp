@@ -0,0 +1,139 @@
+#include "../Sin/simulated_annealing_sin.h"
+#include "../NQueens/simulated_annealing_nqueens.h"
+#include "../cooperative_scheduler.h"
+#include <chrono>
+#include <thread>
+
+/******************************************************************//**
+
+   Benchmark: many small searches on a thread each versus on the 
+   CooperativeScheduler
+
+   Solves the same set of small instances (Sin from a random start angle 
+   and 8-Queens from a random board) with one std::thread per instance 
+   (at most MAX_THREADS alive at once) and with the scheduler in both 
+   modes, and prints the instances solved per second. The last runs give 
+   every instance a deadline and count the instances that were cut off 
+   by it, which is what DEADLINE_PRIORITY is for.
+
+   Links with NQueens/n_queens_board.cpp
+
+***************************************************************************/
+
+typedef std::chrono::steady_clock Clock;
+
+const int INSTANCES = 20000; // half Sin, half 8-Queens
+const long MAX_ITERATIONS = 20000;
+const int MAX_THREADS = 256;
+
+std::vector<CooperativeJob*> createJobs(uint64_t seed, bool deadlines, double maxDeadline){
+	std::vector<CooperativeJob*> jobs;
+	Xoshiro256 rng(seed);
+	Clock::time_point now = Clock::now();
+	for(int i=0; i<INSTANCES; i++){
+		SolveOptions options;
+		options.maxIterations = MAX_ITERATIONS;
+		if(deadlines){
+			options.deadline = now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(maxDeadline*rng.nextDouble()));
+		}
+		if(i%2 == 0){
+			StaticSimulatedAnnealingSin* sin = new StaticSimulatedAnnealingSin(rng.nextInt(360), 1.0, 1, 0.000001, 0.999, seed+i);
+			jobs.push_back(new AnnealJob<StaticSimulatedAnnealingSin>(sin, options));
+		}else{
+			NQueensBoard board(8);
+			for(int j=0; j<8; j++){
+				board.applyRandomSwap(rng);
+			}
+			StaticSimulatedAnnealingNQueens<>* nqueens = new StaticSimulatedAnnealingNQueens<>(board, 0, 1, 1, 0.999, seed+i);
+			jobs.push_back(new AnnealJob<StaticSimulatedAnnealingNQueens<> >(nqueens, options));
+		}
+	}
+	return jobs;
+}
+
+void deleteJobs(std::vector<CooperativeJob*>& jobs){
+	for(size_t i=0; i<jobs.size(); i++){
+		delete jobs[i];
+	}
+	jobs.clear();
+}
+
+void report(const char* variant, double seconds){
+	std::cout << variant << ": " << INSTANCES/seconds << " instances/s" << std::endl;
+}
+
+double runThreadPerInstance(std::vector<CooperativeJob*>& jobs){
+	Clock::time_point start = Clock::now();
+	for(size_t first=0; first<jobs.size(); first+=MAX_THREADS){
+		std::vector<std::thread> threads;
+		for(size_t i=first; i<jobs.size() && i<first+MAX_THREADS; i++){
+			CooperativeJob* job = jobs[i];
+			threads.push_back(std::thread([job](){
+				while(job->resume(LONG_MAX)){
+				}
+				job->finish();
+			}));
+		}
+		for(size_t i=0; i<threads.size(); i++){
+			threads[i].join();
+		}
+	}
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double runScheduler(std::vector<CooperativeJob*>& jobs, CooperativeScheduler::Mode mode){
+	CooperativeScheduler scheduler(mode);
+	Clock::time_point start = Clock::now();
+	for(size_t i=0; i<jobs.size(); i++){
+		scheduler.submit(jobs[i]);
+	}
+	scheduler.wait();
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <class Annealer>
+bool cutOff(CooperativeJob* job){
+	AnnealJob<Annealer>* annealJob = dynamic_cast<AnnealJob<Annealer>*>(job);
+	return annealJob != 0 && annealJob->getResult().stopReason == STOP_DEADLINE;
+}
+
+int countCutOff(const std::vector<CooperativeJob*>& jobs){
+	int count = 0;
+	for(size_t i=0; i<jobs.size(); i++){
+		if(cutOff<StaticSimulatedAnnealingSin>(jobs[i]) || cutOff<StaticSimulatedAnnealingNQueens<> >(jobs[i])){
+			count++;
+		}
+	}
+	return count;
+}
+
+int main(int argc, char *argv[]){
+	const uint64_t SEED = 42;
+
+	std::vector<CooperativeJob*> jobs = createJobs(SEED, false, 0);
+	report("Thread per instance", runThreadPerInstance(jobs));
+	deleteJobs(jobs);
+
+	jobs = createJobs(SEED, false, 0);
+	double roundRobinSeconds = runScheduler(jobs, CooperativeScheduler::ROUND_ROBIN);
+	report("Scheduler, round robin", roundRobinSeconds);
+	deleteJobs(jobs);
+
+	jobs = createJobs(SEED, false, 0);
+	report("Scheduler, deadline priority", runScheduler(jobs, CooperativeScheduler::DEADLINE_PRIORITY));
+	deleteJobs(jobs);
+
+	// deadlines spread uniformly over the time all instances need, so only the order decides 
+	// how many instances make it
+	jobs = createJobs(SEED, true, roundRobinSeconds);
+	runScheduler(jobs, CooperativeScheduler::ROUND_ROBIN);
+	std::cout << "Round robin with deadlines: " << countCutOff(jobs) << " of " << INSTANCES << " cut off" << std::endl;
+	deleteJobs(jobs);
+
+	jobs = createJobs(SEED, true, roundRobinSeconds);
+	runScheduler(jobs, CooperativeScheduler::DEADLINE_PRIORITY);
+	std::cout << "Deadline priority with deadlines: " << countCutOff(jobs) << " of " << INSTANCES << " cut off" << std::endl;
+	deleteJobs(jobs);
+
+	return 0;
+}
@@ -0,0 +1,112 @@
+#include "../Quadtrees/flat_quadtree.h"
+#include "../random_engine.h"
+#include <chrono>
+#include <cmath>
+
+/******************************************************************//**
+
+   Benchmark: Region versus FlatQuadtree
+
+   Fills a Region with N random points and copies it into a
+   FlatQuadtree, then prints the bytes per point of both (see
+   getMemoryUsage(), without the overhead of the allocator, which
+   only Region pays per node) and the time per query of both for
+   closest points, exact total distances, approximate total distances
+   (theta 0.5) and the furthest point, for N = 100 000 and 1 000 000.
+   Both have to give the same answers.
+
+   Links with Quadtrees/pr_quadtree.cpp and Quadtrees/flat_quadtree.cpp
+
+***************************************************************************/
+
+double secondsSince(std::chrono::steady_clock::time_point start){
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char* name, double regionSeconds, double flatSeconds){
+	std::cout << "  " << name << ": region " << regionSeconds*1e6 << " us, flat " << flatSeconds*1e6
+		<< " us, speedup " << regionSeconds/flatSeconds << std::endl;
+}
+
+int main(int argc, char *argv[]){
+	const int SIZES[] = {100000, 1000000};
+	const int SIDE = 1 << 20;
+	const int CLOSEST_QUERIES = 200;
+	const int TOTAL_QUERIES = 20;
+	const int APPROXIMATE_QUERIES = 200;
+	Xoshiro256 rng(42);
+	for(int i=0; i<2; i++){
+		Region* region = new Region(-SIDE, SIDE, -SIDE, SIDE, 0);
+		while(region->getPointCount() < SIZES[i]){
+			region->addPoint(rng.nextInt(2*SIDE+1)-SIDE, rng.nextInt(2*SIDE+1)-SIDE);
+		}
+		FlatQuadtree flat(*region);
+		std::cout << "N=" << SIZES[i] << ": region " << (double)region->getMemoryUsage()/SIZES[i] << " bytes per point, flat "
+			<< (double)flat.getMemoryUsage()/SIZES[i] << " bytes per point (" << flat.getNodeCount() << " nodes)" << std::endl;
+
+		std::vector<double> x(CLOSEST_QUERIES), y(CLOSEST_QUERIES);
+		for(int q=0; q<CLOSEST_QUERIES; q++){
+			x[q] = region->getRandX(rng);
+			y[q] = region->getRandY(rng);
+		}
+		std::vector<Point*> closest(CLOSEST_QUERIES);
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for(int q=0; q<CLOSEST_QUERIES; q++){
+			closest[q] = region->findParentOfClosestPoint(x[q], y[q])->getPoint();
+		}
+		double regionSeconds = secondsSince(start)/CLOSEST_QUERIES;
+		std::vector<int> flatClosest(CLOSEST_QUERIES);
+		start = std::chrono::steady_clock::now();
+		for(int q=0; q<CLOSEST_QUERIES; q++){
+			flatClosest[q] = flat.findClosestPoint(x[q], y[q]);
+		}
+		double flatSeconds = secondsSince(start)/CLOSEST_QUERIES;
+		for(int q=0; q<CLOSEST_QUERIES; q++){
+			double dx = closest[q]->getx()-x[q], dy = closest[q]->gety()-y[q];
+			double flatDx = flat.getX(flatClosest[q])-x[q], flatDy = flat.getY(flatClosest[q])-y[q];
+			assert(dx*dx + dy*dy == flatDx*flatDx + flatDy*flatDy);
+		}
+		report("closest point", regionSeconds, flatSeconds);
+
+		double regionTotal = 0, flatTotal = 0;
+		start = std::chrono::steady_clock::now();
+		for(int q=0; q<TOTAL_QUERIES; q++){
+			regionTotal += region->calcTotalDistance(closest[q]);
+		}
+		regionSeconds = secondsSince(start)/TOTAL_QUERIES;
+		start = std::chrono::steady_clock::now();
+		for(int q=0; q<TOTAL_QUERIES; q++){
+			flatTotal += flat.calcTotalDistance(flatClosest[q]);
+		}
+		flatSeconds = secondsSince(start)/TOTAL_QUERIES;
+		assert(std::fabs(regionTotal-flatTotal) <= 1e-9*regionTotal);
+		report("exact total distance", regionSeconds, flatSeconds);
+
+		double maxError;
+		regionTotal = flatTotal = 0;
+		start = std::chrono::steady_clock::now();
+		for(int q=0; q<APPROXIMATE_QUERIES; q++){
+			regionTotal += region->approximateTotalDistance(closest[q], 0.5, maxError);
+		}
+		regionSeconds = secondsSince(start)/APPROXIMATE_QUERIES;
+		start = std::chrono::steady_clock::now();
+		for(int q=0; q<APPROXIMATE_QUERIES; q++){
+			flatTotal += flat.approximateTotalDistance(flatClosest[q], 0.5, maxError);
+		}
+		flatSeconds = secondsSince(start)/APPROXIMATE_QUERIES;
+		report("approximate total distance", regionSeconds, flatSeconds);
+
+		long regionNodes, flatNodes;
+		start = std::chrono::steady_clock::now();
+		region->findFurthestPoint(regionTotal, regionNodes);
+		regionSeconds = secondsSince(start);
+		start = std::chrono::steady_clock::now();
+		flat.findFurthestPoint(flatTotal, flatNodes);
+		flatSeconds = secondsSince(start);
+		assert(std::fabs(regionTotal-flatTotal) <= 1e-9*regionTotal);
+		report("furthest point", regionSeconds, flatSeconds);
+
+		delete region;
+	}
+	return 0;
+}
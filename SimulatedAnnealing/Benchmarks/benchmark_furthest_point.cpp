@@ -0,0 +1,109 @@
+#include "../Quadtrees/simulated_annealing_quadtrees.h"
+#include <chrono>
+#include <set>
+#include <cmath>
+
+/******************************************************************//**
+
+   Benchmark: finding the point with the largest total distance to
+   all other points exactly (Region::findFurthestPoint) versus with
+   the annealer
+
+   Fills a Region with N random points and prints the time, the
+   regions visited and the total of the branch and bound search for
+   N = 10 000, 100 000 and 1 000 000. Up to 100 000 points it also
+   prints the time and the total of 2 000 iterations of
+   StaticSimulatedAnnealingQuadtrees (with approximated totals,
+   theta 0.5, and a temperature low enough to only go up) from the
+   same region, with how far that total is below the exact one. The
+   proposals of the annealer (findParentOfClosestPoint) take most of
+   its time.
+
+   First the search is checked against summing the distances of
+   every point (calcTotalDistance) on circles of 2 000 points far
+   from the origin, where the bounds are the most sensitive to
+   rounding and the totals of the points are close together.
+
+   Links with Quadtrees/pr_quadtree.cpp
+
+***************************************************************************/
+
+double secondsSince(std::chrono::steady_clock::time_point start){
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//points on a circle in a box at (offset, offset), their totals are close together so small errors 
+//in the bounds change the result, asserts that the search finds the largest total
+void checkAgainstAllTotals(double offset, Xoshiro256& rng){
+	const int SIDE = 1 << 12;
+	const int POINTS = 2000;
+	Region region(offset, offset+SIDE, offset, offset+SIDE, 0);
+	std::set<std::pair<int, int> > added;
+	std::vector<Point> points;
+	while((int)points.size() < POINTS){
+		double angle = rng.nextDouble()*6.283185307179586;
+		int x = SIDE/2 + (int)(SIDE/2*cos(angle));
+		int y = SIDE/2 + (int)(SIDE/2*sin(angle));
+		if(added.insert(std::make_pair(x, y)).second){
+			region.addPoint(offset+x, offset+y);
+			points.push_back(Point(offset+x, offset+y));
+		}
+	}
+	double largest = 0;
+	for(int i=0; i<POINTS; i++){
+		largest = std::max(largest, region.calcTotalDistance(&points[i]));
+	}
+	double total;
+	long nodesVisited;
+	Point* furthest = region.findFurthestPoint(total, nodesVisited);
+	assert(furthest != 0 && total == largest && region.calcTotalDistance(furthest) == largest);
+}
+
+int main(int argc, char *argv[]){
+	const int SIZES[] = {10000, 100000, 1000000};
+	const long ITERATIONS = 2000;
+	const int SIDE = 1 << 20;
+	const double OFFSETS[] = {0, 1e6, 1e9, 3e12};
+	const int CIRCLES = 20;
+	Xoshiro256 rng(42);
+	for(int i=0; i<4; i++){
+		for(int circle=0; circle<CIRCLES; circle++){
+			checkAgainstAllTotals(OFFSETS[i], rng);
+		}
+		std::cout << "offset " << OFFSETS[i] << ": found the largest total on " << CIRCLES << " circles of points" << std::endl;
+	}
+	for(int i=0; i<3; i++){
+		Region region(-SIDE, SIDE, -SIDE, SIDE, 0);
+		while(region.getPointCount() < SIZES[i]){
+			region.addPoint(rng.nextInt(2*SIDE+1)-SIDE, rng.nextInt(2*SIDE+1)-SIDE);
+		}
+
+		double exactTotal;
+		long nodesVisited;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		Point* furthest = region.findFurthestPoint(exactTotal, nodesVisited);
+		double exactSeconds = secondsSince(start);
+		assert(furthest != 0);
+		std::cout << "N=" << SIZES[i] << ": branch and bound " << exactSeconds << "s, " << nodesVisited << " regions, total "
+			<< exactTotal << std::endl;
+		if(SIZES[i] > 100000){
+			continue;
+		}
+
+		QuadtreeSolution startSolution(&region, rng);
+		StaticSimulatedAnnealingQuadtrees annealer(startSolution, 0, 1e-30, 0, 1, 42);
+		annealer.setTheta(0.5);
+		start = std::chrono::steady_clock::now();
+		annealer.evaluateSolution();
+		for(long it=0; it<ITERATIONS; it++){
+			annealer.step();
+			annealer.coolDown();
+		}
+		double annealSeconds = secondsSince(start);
+		double annealTotal = region.calcTotalDistance(annealer.getSolution().getCurrentFurthest());
+
+		std::cout << "  annealing " << annealSeconds << "s, total " << annealTotal << " ("
+			<< (exactTotal-annealTotal)/exactTotal*100 << "% below)" << std::endl;
+	}
+	return 0;
+}
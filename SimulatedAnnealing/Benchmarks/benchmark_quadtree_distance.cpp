@@ -0,0 +1,68 @@
+#include "../Quadtrees/pr_quadtree.h"
+#include "../random_engine.h"
+#include <chrono>
+#include <cmath>
+
+/******************************************************************//**
+
+   Benchmark: the exact total distance of a point to all other
+   points of a Region versus the Barnes-Hut approximation
+   (Region::approximateTotalDistance)
+
+   Fills a Region with N random points, picks 200 of them and prints
+   the time per evaluation of the exact sum and of the approximation
+   for theta = 0.3, 0.5 and 1, with the largest relative error seen
+   and the largest relative error bound the approximation reported,
+   for N = 10 000, 100 000 and 1 000 000.
+
+   Links with Quadtrees/pr_quadtree.cpp
+
+***************************************************************************/
+
+double secondsSince(std::chrono::steady_clock::time_point start){
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[]){
+	const int SIZES[] = {10000, 100000, 1000000};
+	const double THETAS[] = {0.3, 0.5, 1};
+	const int QUERIES = 200;
+	const int SIDE = 1 << 20;
+	Xoshiro256 rng(42);
+	for(int i=0; i<3; i++){
+		Region region(-SIDE, SIDE, -SIDE, SIDE, 0);
+		while(region.getPointCount() < SIZES[i]){
+			region.addPoint(rng.nextInt(2*SIDE+1)-SIDE, rng.nextInt(2*SIDE+1)-SIDE);
+		}
+		std::vector<Point*> queries;
+		for(int q=0; q<QUERIES; q++){
+			queries.push_back(region.findParentOfClosestPoint(region.getRandX(rng), region.getRandY(rng))->getPoint());
+		}
+
+		std::vector<double> exact(QUERIES);
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for(int q=0; q<QUERIES; q++){
+			exact[q] = region.calcTotalDistance(queries[q]);
+		}
+		double exactSeconds = secondsSince(start)/QUERIES;
+		std::cout << "N=" << SIZES[i] << ": exact " << exactSeconds*1e6 << " us" << std::endl;
+
+		for(int t=0; t<3; t++){
+			double worstError = 0, worstBound = 0;
+			std::vector<double> approximate(QUERIES), maxError(QUERIES);
+			start = std::chrono::steady_clock::now();
+			for(int q=0; q<QUERIES; q++){
+				approximate[q] = region.approximateTotalDistance(queries[q], THETAS[t], maxError[q]);
+			}
+			double seconds = secondsSince(start)/QUERIES;
+			for(int q=0; q<QUERIES; q++){
+				worstError = std::max(worstError, std::fabs(approximate[q]-exact[q])/exact[q]);
+				worstBound = std::max(worstBound, maxError[q]/exact[q]);
+				assert(std::fabs(approximate[q]-exact[q]) <= maxError[q] + 1e-9*exact[q]);
+			}
+			std::cout << "  theta=" << THETAS[t] << ": " << seconds*1e6 << " us, speedup " << exactSeconds/seconds
+				<< ", relative error " << worstError << " (bound " << worstBound << ")" << std::endl;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,101 @@
+#include "../NQueens/permutation_board.h"
+#include "../NQueens/queen_positions.h"
+#include "../random_engine.h"
+#include <chrono>
+#include <fstream>
+#include <cstdio>
+
+/******************************************************************//**
+
+   Benchmark: writing an N-Queens result as the ASCII grid operator<<
+   used to print (one << per square) versus as queen positions, in
+   text and in binary, and reading a position file back and scoring
+   it
+
+   The board is a shuffled PermutationBoard. The grid has (2N+3)*N
+   characters, so it's only written up to N = 10 000. Prints the
+   seconds and the file size of every variant for N = 1 000, 10 000
+   and 1 000 000. The files are written to the working directory and
+   removed afterwards.
+
+   Links with NQueens/permutation_board.cpp and NQueens/queen_positions.cpp
+
+***************************************************************************/
+
+//the grid as NQueensBoard::print() wrote it before (without the separator lines)
+void writeGrid(std::ostream& output, const PermutationBoard& board){
+	int n = board.getSize();
+	for(int i=0; i< (2*n+3); i++) output << "*";
+	output << std::endl;
+	for(int h=0; h<n; h++){
+		output << "*|";
+		for(int w=0; w<n; w++){
+			output << "" << (board.getColumn(h) == w ? "Q" : " ") << "|";
+		}
+		output << "*" << std::endl;
+	}
+	for(int i=0; i< (2*n+3); i++) output << "*";
+	output << std::endl;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start){
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+long fileSize(const char* path){
+	FILE* file = fopen(path, "rb");
+	if(file == 0){
+		return -1;
+	}
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fclose(file);
+	return size;
+}
+
+int main(int argc, char *argv[]){
+	const int SIZES[] = {1000, 10000, 1000000};
+	const char* GRID = "benchmark_queens.grid";
+	const char* TEXT = "benchmark_queens.txt";
+	const char* BINARY = "benchmark_queens.bin";
+	Xoshiro256 rng(42);
+	for(int i=0; i<3; i++){
+		int n = SIZES[i];
+		PermutationBoard board(n);
+		board.shuffle(rng);
+		std::cout << "N=" << n << " (" << board.getErrors() << " errors)" << std::endl;
+
+		if(n <= 10000){
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			{
+				std::ofstream grid(GRID);
+				writeGrid(grid, board);
+			}
+			std::cout << "  grid:   " << secondsSince(start) << "s, " << fileSize(GRID) << " bytes" << std::endl;
+			remove(GRID);
+		}
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		bool written = writeQueenPositions(TEXT, board.getColumns(), QUEENS_TEXT);
+		double writeSeconds = secondsSince(start);
+		start = std::chrono::steady_clock::now();
+		long long errors = verifyQueenPositions(TEXT);
+		double verifySeconds = secondsSince(start);
+		assert(written && errors == board.getErrors());
+		std::cout << "  text:   " << writeSeconds << "s, " << fileSize(TEXT) << " bytes, read back and scored in "
+			<< verifySeconds << "s" << std::endl;
+		remove(TEXT);
+
+		start = std::chrono::steady_clock::now();
+		written = writeQueenPositions(BINARY, board.getColumns(), QUEENS_BINARY);
+		writeSeconds = secondsSince(start);
+		start = std::chrono::steady_clock::now();
+		errors = verifyQueenPositions(BINARY);
+		verifySeconds = secondsSince(start);
+		assert(written && errors == board.getErrors());
+		std::cout << "  binary: " << writeSeconds << "s, " << fileSize(BINARY) << " bytes, read back and scored in "
+			<< verifySeconds << "s" << std::endl;
+		remove(BINARY);
+	}
+	return 0;
+}
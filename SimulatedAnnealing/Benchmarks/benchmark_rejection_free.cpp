@@ -0,0 +1,71 @@
+#include "../NQueens/simulated_annealing_permutation_nqueens.h"
+#include <chrono>
+
+/******************************************************************//**
+
+   Benchmark: normal versus rejection-free steps for N-Queens on a
+   PermutationBoard
+
+   Runs the same number of iterations (for the rejection-free steps:
+   the iterations they stand for) with both kinds of steps, from the
+   same shuffled board with the same seed, and prints the share of
+   accepted proposals and the iterations per second. The first runs
+   hold the temperature constant, the last ones cool down from 0.3 to
+   0.03 over the run, both kinds of steps have to end at about the
+   same temperature.
+
+   Normal steps also count the proposals that swap a queen with
+   itself (1 in N) as accepted. A rejection-free step costs O(N)
+   swap scores, a normal iteration one, so rejection-free steps only
+   win on small boards at low temperatures: at N=8 and T=0.08 the
+   board is solved and hardly any swap is accepted. On larger boards
+   swaps that don't change the errors keep about 1% of the proposals
+   accepted at any temperature, which is too many for them to pay
+   off.
+
+   Links with NQueens/permutation_board.cpp
+
+***************************************************************************/
+
+double iterationsPerSecond(const PermutationBoard& startSolution, double temp, double alpha, bool rejectionFree, long iterations, double& acceptanceRate, double& endTemp){
+	StaticSimulatedAnnealingPermutationNQueens<> annealer(startSolution, 0, temp, 0, alpha, 42);
+	if(rejectionFree){
+		annealer.setRejectionFreeTemp(2*temp);
+	}
+	annealer.evaluateSolution();
+	long accepted = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	while(annealer.getIteration() < iterations){
+		accepted += annealer.step();
+		annealer.coolDown();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	acceptanceRate = (double)accepted/annealer.getIteration();
+	endTemp = annealer.getTemp();
+	return annealer.getIteration()/seconds;
+}
+
+void compare(const PermutationBoard& startSolution, double temp, double alpha, long iterations){
+	double normalAcceptance, rejectionFreeAcceptance, normalEndTemp, rejectionFreeEndTemp;
+	double normalRate = iterationsPerSecond(startSolution, temp, alpha, false, iterations, normalAcceptance, normalEndTemp);
+	double rejectionFreeRate = iterationsPerSecond(startSolution, temp, alpha, true, iterations, rejectionFreeAcceptance, rejectionFreeEndTemp);
+	std::cout << "N=" << startSolution.getSize() << ", T=" << temp << " to " << normalEndTemp << " / " << rejectionFreeEndTemp 
+		<< ": accepted " << normalAcceptance*100 << "% / " << rejectionFreeAcceptance*100 << "%, normal " << normalRate 
+		<< " it/s, rejection-free " << rejectionFreeRate << " it/s, speedup " << rejectionFreeRate/normalRate << std::endl;
+}
+
+int main(int argc, char *argv[]){
+	const int SIZES[] = {8, 16, 32, 128};
+	const double TEMPS[] = {0.3, 0.15, 0.08};
+	const long ITERATIONS = 2000000;
+	for(int i=0; i<4; i++){
+		Xoshiro256 rng(7);
+		PermutationBoard startSolution(SIZES[i]);
+		startSolution.shuffle(rng);
+		for(int j=0; j<3; j++){
+			compare(startSolution, TEMPS[j], 1, ITERATIONS);
+		}
+		compare(startSolution, 0.3, pow(0.1, 1.0/ITERATIONS), ITERATIONS);
+	}
+	return 0;
+}
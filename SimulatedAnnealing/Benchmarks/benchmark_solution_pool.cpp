@@ -0,0 +1,79 @@
+#include "../NQueens/simulated_annealing_nqueens.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+/******************************************************************//**
+
+   Benchmark: HeapSolutionAllocator versus SolutionPool
+
+   Runs the NQueens problem with the COPY_NEIGHBOUR interface (every
+   iteration copies the board) at a constant temperature, first one
+   solver alone and then several solvers at once in their own
+   threads, with both allocators, and prints the iterations per
+   second of all solvers together.
+
+   Links with NQueens/n_queens_board.cpp
+
+***************************************************************************/
+
+template <class Allocator>
+class CopyNQueens:public StaticSimulatedAnnealing<CopyNQueens<Allocator>, NQueensBoard, int, Xoshiro256, GeometricCooling, MetropolisAcceptance, Allocator>{
+
+	typedef StaticSimulatedAnnealing<CopyNQueens<Allocator>, NQueensBoard, int, Xoshiro256, GeometricCooling, MetropolisAcceptance, Allocator> Base;
+
+public:
+
+	NQueensBoard* giveRandomNeighbour(const NQueensBoard& lastSolution) const{
+		NQueensBoard* neighbour = this->copySolution(lastSolution);
+		neighbour->applyRandomSwap(this->rng);
+		return neighbour;
+	}
+
+	double calcDistanceToTarget(const NQueensBoard& solution) const{
+		return solution.getErrors()-(*this->TARGET);
+	}
+
+	CopyNQueens(const NQueensBoard& startSolution, uint64_t seed):Base(startSolution, 0, 1, 0, 1, seed){}
+
+};
+
+template <class Allocator>
+void run(int n, long iterations, uint64_t seed){
+	NQueensBoard startSolution(n);
+	CopyNQueens<Allocator> annealer(startSolution, seed);
+	annealer.evaluateSolution();
+	for(long i=0; i<iterations; i++){
+		annealer.step();
+		annealer.coolDown();
+	}
+}
+
+template <class Allocator>
+double iterationsPerSecond(int n, long iterations, int nSolvers){
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for(int i=0; i<nSolvers; i++){
+		threads.push_back(std::thread(run<Allocator>, n, iterations, (uint64_t)i));
+	}
+	for(int i=0; i<nSolvers; i++){
+		threads[i].join();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return iterations*nSolvers/seconds;
+}
+
+int main(int argc, char *argv[]){
+	const int SIZES[] = {16, 64};
+	const int SOLVERS[] = {1, 4};
+	for(int i=0; i<2; i++){
+		long iterations = 4000000/SIZES[i];
+		for(int j=0; j<2; j++){
+			double heapRate = iterationsPerSecond<HeapSolutionAllocator<NQueensBoard> >(SIZES[i], iterations, SOLVERS[j]);
+			double poolRate = iterationsPerSecond<SolutionPool<NQueensBoard> >(SIZES[i], iterations, SOLVERS[j]);
+			std::cout << "N=" << SIZES[i] << ", " << SOLVERS[j] << " solver(s): heap " << heapRate << " it/s, pool "
+				<< poolRate << " it/s, speedup " << poolRate/heapRate << std::endl;
+		}
+	}
+	return 0;
+}
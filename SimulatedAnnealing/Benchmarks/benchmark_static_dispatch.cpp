@@ -0,0 +1,80 @@
+#include "../Sin/simulated_annealing_sin.h"
+#include "../NQueens/simulated_annealing_nqueens.h"
+#include "../Quadtrees/simulated_annealing_quadtrees.h"
+#include <chrono>
+#include <set>
+
+/******************************************************************//**
+
+   Benchmark: virtual (SimulatedAnnealing) versus static 
+   (StaticSimulatedAnnealing) hooks
+
+   Runs the same number of iterations of every bundled problem with 
+   both variants, from the same start and with the same seed, at a 
+   constant temperature, and prints the iterations per second.
+
+   Links with NQueens/n_queens_board.cpp and Quadtrees/pr_quadtree.cpp
+
+***************************************************************************/
+
+template <class Annealer>
+double iterationsPerSecond(Annealer& annealer, long iterations){
+	annealer.evaluateSolution();
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(long i=0; i<iterations; i++){
+		annealer.step();
+		annealer.coolDown();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return iterations/seconds;
+}
+
+void report(const char* problem, double virtualRate, double staticRate){
+	std::cout << problem << ": virtual " << virtualRate << " it/s, static " << staticRate
+		<< " it/s, speedup " << staticRate/virtualRate << std::endl;
+}
+
+int main(int argc, char *argv[]){
+	const uint64_t SEED = 42;
+
+	// alpha 1 keeps the temperature (and so the acceptance rate) constant
+	{
+		const long ITERATIONS = 20000000;
+		SimulatedAnnealingSin virtualSin(30.0, 1.0, 0.01, 0, 1, SEED);
+		StaticSimulatedAnnealingSin staticSin(30.0, 1.0, 0.01, 0, 1, SEED);
+		double virtualRate = iterationsPerSecond(virtualSin, ITERATIONS);
+		double staticRate = iterationsPerSecond(staticSin, ITERATIONS);
+		report("Sin", virtualRate, staticRate);
+	}
+
+	{
+		const long ITERATIONS = 20000;
+		NQueensBoard startSolution(64);
+		SimulatedAnnealingNQueens<> virtualNQueens(startSolution, 0, 1, 0, 1, SEED);
+		StaticSimulatedAnnealingNQueens<> staticNQueens(startSolution, 0, 1, 0, 1, SEED);
+		double virtualRate = iterationsPerSecond(virtualNQueens, ITERATIONS);
+		double staticRate = iterationsPerSecond(staticNQueens, ITERATIONS);
+		report("NQueens (N=64)", virtualRate, staticRate);
+	}
+
+	{
+		const long ITERATIONS = 20000;
+		Xoshiro256 rng(SEED);
+		Region reg(-300,300,-300,300,0);
+		std::set<std::pair<double, double> > points; // addPoint refuses (and reports) duplicates
+		while(points.size() < 2000){
+			std::pair<double, double> p(reg.getRandX(rng), reg.getRandY(rng));
+			if(points.insert(p).second){
+				reg.addPoint(p.first, p.second);
+			}
+		}
+		QuadtreeSolution startSolution(&reg, rng);
+		SimulatedAnnealingQuadtrees virtualQuadtrees(startSolution, 0, 0.0001, 0, 1, SEED);
+		StaticSimulatedAnnealingQuadtrees staticQuadtrees(startSolution, 0, 0.0001, 0, 1, SEED);
+		double virtualRate = iterationsPerSecond(virtualQuadtrees, ITERATIONS);
+		double staticRate = iterationsPerSecond(staticQuadtrees, ITERATIONS);
+		report("Quadtrees (2000 points)", virtualRate, staticRate);
+	}
+
+	return 0;
+}
@@ -0,0 +1,29 @@
+#ifndef __BIT_COUNT_H
+#define __BIT_COUNT_H
+
+#include <stdint.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//number of set bits, a single instruction where the hardware has one
+inline int popCount(uint64_t bits){
+#ifdef _MSC_VER
+	return (int)__popcnt64(bits);
+#else
+	return __builtin_popcountll(bits);
+#endif
+}
+
+//index of the lowest set bit, bits can't be 0
+inline int lowestBit(uint64_t bits){
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, bits);
+	return (int)index;
+#else
+	return __builtin_ctzll(bits);
+#endif
+}
+
+#endif
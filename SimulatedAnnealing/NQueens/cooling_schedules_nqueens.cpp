@@ -0,0 +1,55 @@
+#include "simulated_annealing_nqueens.h"
+#include <ctime>	// needed for random seed
+
+/******************************************************************//**
+
+   Example of the use of the cooling schedules and acceptance rules
+   Solves the same N-Queens board from the same seed with every cooling 
+   schedule (using Metropolis acceptance) and every acceptance rule 
+   (using a fitting schedule) and prints the number of iterations needed
+
+***************************************************************************/
+
+const int N = 30;
+const long MAX_ITERATIONS = 200000;
+
+template <class Cooling, class Acceptance>
+void run(const char* name, double starttemp, const Cooling& cooling, const Acceptance& acceptance, uint64_t seed){
+	Xoshiro256 rng(seed);
+	NQueensBoard startSolution(N);
+	for(int i=0; i<N; i++){
+		startSolution.applyRandomSwap(rng);
+	}
+
+	StaticSimulatedAnnealingNQueens<Cooling, Acceptance> sanq(startSolution, 0, starttemp, 1, 0.999, seed);
+	sanq.setCooling(cooling);
+	sanq.setAcceptance(acceptance);
+	sanq.evaluateSolution();
+	while(!sanq.reachedPrecision() && sanq.getIteration() < MAX_ITERATIONS){
+		sanq.step();
+		sanq.coolDown();
+	}
+
+	std::cout << name << ": " << (sanq.reachedPrecision() ? "solved" : "not solved") << " after " 
+		<< sanq.getIteration() << " iterations, errors left: " << sanq.getDistance() << std::endl;
+}
+
+int main(int argc, char *argv[]){
+	uint64_t seed = (uint64_t)time(0);
+
+	std::cout << "Cooling schedules (Metropolis acceptance)" << std::endl;
+	run("Geometric", 2, GeometricCooling(0.9995), MetropolisAcceptance(), seed);
+	run("Linear", 2, LinearCooling(2.0/20000), MetropolisAcceptance(), seed);
+	run("Logarithmic", 2, LogarithmicCooling(1), MetropolisAcceptance(), seed);
+	run("Lundy-Mees", 2, LundyMeesCooling(0.001), MetropolisAcceptance(), seed);
+	run("Exponential with reheat", 2, ReheatingCooling(0.999, 2000, 0.5), MetropolisAcceptance(), seed);
+	run("Lam adaptive", 2, LamCooling(0.999, 50000), MetropolisAcceptance(), seed);
+
+	std::cout << std::endl << "Acceptance rules" << std::endl;
+	run("Metropolis (geometric)", 2, GeometricCooling(0.9995), MetropolisAcceptance(), seed);
+	run("Threshold accepting (linear)", 1.5, LinearCooling(1.5/20000), ThresholdAcceptance(), seed);
+	run("Great deluge (linear)", 2*N, LinearCooling(2.0*N/20000), GreatDelugeAcceptance(), seed);
+	run("Tsallis q=1.5 (geometric)", 2, GeometricCooling(0.9995), TsallisAcceptance(1.5), seed);
+
+	return 0;
+}
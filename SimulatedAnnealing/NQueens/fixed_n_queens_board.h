@@ -0,0 +1,294 @@
+#ifndef __FIXED_N_QUEENS_BOARD_H
+#define __FIXED_N_QUEENS_BOARD_H
+
+#include <iostream>
+#include <assert.h>
+#include <array>
+#include <utility>
+#include <stdint.h>
+#include "../checkpoint.h"
+#include "bit_count.h"
+
+/******************************************************************//**
+
+   FixedNQueensBoard
+
+   NQueensBoard with the size as template parameter, for the sizes
+   that are known when compiling (e.g. 8 to 256). The same interface
+   and error count as NQueensBoard, so it plugs into the same
+   annealers (see StaticSimulatedAnnealingNQueens).
+
+   The squares are bit-packed in a std::array that is part of the
+   object: no heap allocation, the object is trivially copyable (a
+   copy is a memcpy), and the loops over rows, words and diagonals
+   have constant bounds the compiler can unroll and vectorize.
+
+   Like NQueensBoard it keeps the number of queens of every line
+   (in a std::array as well), setQueen, unsetQueen and a swap only
+   update the lines of the queens they move.
+
+***************************************************************************/
+
+template <int N>
+class FixedNQueensBoard{
+
+public:
+	static const int WORDS = (N+63)/64; // 64 bit words per row
+	static const int DIAGONALS = 2*N-1; // diagonals per direction
+
+	//all queens on the main diagonal, like NQueensBoard(N)
+	FixedNQueensBoard();
+
+	void print(std::ostream& output) const;
+	void setQueen(int h, int w);
+	void unsetQueen(int h, int w);
+	template <class RNG> FixedNQueensBoard* returnRandomNeighbour(RNG& rng) const;
+	//in-place variant of returnRandomNeighbour, the last swap can be reverted with undoSwap
+	template <class RNG> void applyRandomSwap(RNG& rng);
+	//swaps rows row1/row2 and columns col1/col2 (0 based) and updates the errors
+	void applySwap(int row1, int row2, int col1, int col2);
+	void undoSwap();
+
+	int getErrors() const;
+
+	//index of the diagonals through square (h, w), 0 based
+	static constexpr int diagUp(int h, int w){ return h+w; }
+	static constexpr int diagDown(int h, int w){ return h-w+N-1; }
+
+	friend std::ostream& operator<<(std::ostream& output, const FixedNQueensBoard& board){
+		output << "Errors: " << board.getErrors() << std::endl;
+		board.print(output);
+		return output;
+	}
+
+	//checkpoint hooks (see checkpoint.h)
+	friend void writeCheckpoint(CheckpointWriter& writer, const FixedNQueensBoard& board){
+		writer.write(N);
+		writer.write(board);
+	}
+
+	friend bool readCheckpoint(CheckpointReader& reader, FixedNQueensBoard& board){
+		int n = 0;
+		if(!reader.read(n) || n != N){
+			return false;
+		}
+		if(!reader.read(board)){
+			return false;
+		}
+		board.calcErrors(); // the counters aren't trusted
+		return true;
+	}
+
+private:
+	std::array<std::array<uint64_t, WORDS>, N> board;
+	std::array<int, 6*N-2> counts; // queens per line: rows, columns, diagonals row+column, diagonals row-column+N-1
+	int nQueens;
+	int nErrorsCache;
+
+	//last swap done by applyRandomSwap, a swap undoes itself
+	int lastRow1, lastRow2, lastCol1, lastCol2;
+
+	bool hasQueen(int h, int w) const;
+	void swapRowsAndColumns(int row1, int row2, int col1, int col2);
+	//counts all lines again
+	void calcErrors();
+
+	static int nErrors(int nQueens);
+
+	//adds change queens to a line and keeps nErrorsCache up to date
+	void addToLine(int& count, int change);
+	void moveQueenRow(int w, int fromRow, int toRow);
+	void moveQueenColumn(int h, int fromColumn, int toColumn);
+
+};
+
+template <int N>
+FixedNQueensBoard<N>::FixedNQueensBoard():nQueens(N),nErrorsCache(0),lastRow1(0),lastRow2(0),lastCol1(0),lastCol2(0){
+	static_assert(N > 0, "a board needs at least one square");
+	for(int h=0; h<N; h++){
+		board[h].fill(0);
+		board[h][h >> 6] |= (uint64_t)1 << (h & 63);
+	}
+	calcErrors();
+}
+
+template <int N>
+void FixedNQueensBoard<N>::print(std::ostream& output) const{
+	//upper line
+	for(int i=0; i< (2*N+3); i++) output << "*";
+	output << std::endl;
+
+	for(int h=0; h<N; h++){
+		output << "*|";
+		for(int w=0; w<N; w++){
+			output << "" << (hasQueen(h, w)?"Q":" ") << "|";
+		}
+		output << "*" << std::endl;
+	}
+
+	//lower line
+	for(int i=0; i< (2*N+3); i++) output << "*";
+	output << "\n\n\n" << std::endl;
+}
+
+template <int N>
+void FixedNQueensBoard<N>::setQueen(int h, int w){
+	assert(h >= 1 && h <= N && w >= 1 && w <= N);
+	if(!hasQueen(h-1, w-1)){
+		board[h-1][(w-1) >> 6] |= (uint64_t)1 << ((w-1) & 63);
+		nQueens++;
+		addToLine(counts[h-1], 1);
+		addToLine(counts[N + w-1], 1);
+		addToLine(counts[2*N + diagUp(h-1, w-1)], 1);
+		addToLine(counts[4*N-1 + diagDown(h-1, w-1)], 1);
+	}
+}
+
+template <int N>
+void FixedNQueensBoard<N>::unsetQueen(int h, int w){
+	assert(h >= 1 && h <= N && w >= 1 && w <= N);
+	if(hasQueen(h-1, w-1)){
+		board[h-1][(w-1) >> 6] &= ~((uint64_t)1 << ((w-1) & 63));
+		nQueens--;
+		addToLine(counts[h-1], -1);
+		addToLine(counts[N + w-1], -1);
+		addToLine(counts[2*N + diagUp(h-1, w-1)], -1);
+		addToLine(counts[4*N-1 + diagDown(h-1, w-1)], -1);
+	}
+}
+
+template <int N>
+template <class RNG>
+FixedNQueensBoard<N>* FixedNQueensBoard<N>::returnRandomNeighbour(RNG& rng) const{
+	FixedNQueensBoard* boardcopy = new FixedNQueensBoard(*this);
+	boardcopy->applyRandomSwap(rng);
+	return boardcopy;
+}
+
+template <int N>
+template <class RNG>
+void FixedNQueensBoard<N>::applyRandomSwap(RNG& rng){
+	int row1 = rng.nextInt(N);
+	int row2 = rng.nextInt(N);
+	int col1 = rng.nextInt(N);
+	int col2 = rng.nextInt(N);
+	applySwap(row1, row2, col1, col2);
+}
+
+template <int N>
+void FixedNQueensBoard<N>::applySwap(int row1, int row2, int col1, int col2){
+	lastRow1 = row1;
+	lastRow2 = row2;
+	lastCol1 = col1;
+	lastCol2 = col2;
+
+	swapRowsAndColumns(row1, row2, col1, col2);
+}
+
+template <int N>
+void FixedNQueensBoard<N>::undoSwap(){
+	//row and column swaps commute and undo themselves
+	swapRowsAndColumns(lastRow1, lastRow2, lastCol1, lastCol2);
+}
+
+template <int N>
+inline bool FixedNQueensBoard<N>::hasQueen(int h, int w) const{
+	return (board[h][w >> 6] >> (w & 63)) & 1;
+}
+
+//only the lines of the queens that move are updated
+template <int N>
+void FixedNQueensBoard<N>::swapRowsAndColumns(int row1, int row2, int col1, int col2){
+	if( row1 != row2 ){
+		for(int word=0; word<WORDS; word++){
+			for(uint64_t bits = board[row1][word]; bits; bits &= bits-1){
+				moveQueenRow((word << 6) + lowestBit(bits), row1, row2);
+			}
+			for(uint64_t bits = board[row2][word]; bits; bits &= bits-1){
+				moveQueenRow((word << 6) + lowestBit(bits), row2, row1);
+			}
+		}
+		std::swap(board[row1], board[row2]);
+	}
+
+	if( col1 != col2){
+		int word1 = col1 >> 6, shift1 = col1 & 63;
+		int word2 = col2 >> 6, shift2 = col2 & 63;
+		for(int i=0; i<N; i++){
+			uint64_t differ = ((board[i][word1] >> shift1) ^ (board[i][word2] >> shift2)) & 1;
+			if(differ){
+				if((board[i][word1] >> shift1) & 1){
+					moveQueenColumn(i, col1, col2);
+				}else{
+					moveQueenColumn(i, col2, col1);
+				}
+				board[i][word1] ^= differ << shift1;
+				board[i][word2] ^= differ << shift2;
+			}
+		}
+	}
+}
+
+template <int N>
+void FixedNQueensBoard<N>::calcErrors(){
+	counts.fill(0);
+	int* columns = &counts[N];
+	int* up = &counts[2*N];
+	int* down = &counts[4*N-1];
+	for(int h=0; h<N; h++){
+		for(int word=0; word<WORDS; word++){
+			uint64_t bits = board[h][word];
+			counts[h] += popCount(bits);
+			//queens are sparse, only the set bits are visited
+			while(bits){
+				int w = (word << 6) + lowestBit(bits);
+				columns[w]++;
+				up[diagUp(h, w)]++;
+				down[diagDown(h, w)]++;
+				bits &= bits-1;
+			}
+		}
+	}
+	nErrorsCache = 0;
+	for(int i=0; i<6*N-2; i++){
+		nErrorsCache += nErrors(counts[i]);
+	}
+}
+
+template <int N>
+inline int FixedNQueensBoard<N>::nErrors(int nQueens){
+	return nQueens > 1 ? nQueens-1 : 0;
+}
+
+template <int N>
+inline int FixedNQueensBoard<N>::getErrors() const{
+	return nErrorsCache;
+}
+
+template <int N>
+inline void FixedNQueensBoard<N>::addToLine(int& count, int change){
+	nErrorsCache += nErrors(count+change) - nErrors(count);
+	count += change;
+}
+
+template <int N>
+inline void FixedNQueensBoard<N>::moveQueenRow(int w, int fromRow, int toRow){
+	addToLine(counts[fromRow], -1);
+	addToLine(counts[2*N + diagUp(fromRow, w)], -1);
+	addToLine(counts[4*N-1 + diagDown(fromRow, w)], -1);
+	addToLine(counts[toRow], 1);
+	addToLine(counts[2*N + diagUp(toRow, w)], 1);
+	addToLine(counts[4*N-1 + diagDown(toRow, w)], 1);
+}
+
+template <int N>
+inline void FixedNQueensBoard<N>::moveQueenColumn(int h, int fromColumn, int toColumn){
+	addToLine(counts[N + fromColumn], -1);
+	addToLine(counts[2*N + diagUp(h, fromColumn)], -1);
+	addToLine(counts[4*N-1 + diagDown(h, fromColumn)], -1);
+	addToLine(counts[N + toColumn], 1);
+	addToLine(counts[2*N + diagUp(h, toColumn)], 1);
+	addToLine(counts[4*N-1 + diagDown(h, toColumn)], 1);
+}
+
+#endif
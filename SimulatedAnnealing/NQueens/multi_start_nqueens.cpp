@@ -0,0 +1,43 @@
+#include "../multi_start.h"
+#include "simulated_annealing_nqueens.h"
+#include <ctime>	// needed for random seed
+
+/******************************************************************//**
+
+   Example of the use of the MultiStart class
+   Solves the N-Queens problem with many independent SimulatedAnnealingNQueens
+   chains, every chain starts from its own random board
+
+***************************************************************************/
+
+const int N = 50;
+
+SimulatedAnnealing<NQueensBoard, int>* createChain(int index, uint64_t seed){
+	Xoshiro256 rng(seed);
+	NQueensBoard startSolution(N);
+	for(int i=0; i<N; i++){
+		startSolution.applyRandomSwap(rng);
+	}
+	return new SimulatedAnnealingNQueens<>(startSolution, 0, 5*10E5, 1, 0.6, seed);
+}
+
+int main(int argc, char *argv[]){
+	const int CHAINS = 64;
+
+	MultiStart<NQueensBoard, int> ms(createChain, CHAINS, (uint64_t)time(0));
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	bool solved = ms.run(60);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	long iterations = 0;
+	for(int i=0; i<CHAINS; i++){
+		iterations += ms.getIterations(i);
+	}
+
+	std::cout << (solved ? "Solution found" : "No solution found") << " by chain " << ms.getBestChain()
+		<< " after " << seconds << "s and " << iterations << " iterations over all chains" << std::endl << std::endl;
+	std::cout << *ms.getBestSolution() << std::endl;
+
+	return 0;
+}
@@ -1,89 +1,117 @@
 #include "n_queens_board.h"
+#include "bit_count.h"
+#include "../thread_pool.h"
+#include <string>
+#include <memory>
+#include <atomic>
 
-NQueensBoard::NQueensBoard(int n):N(n){
-	board = new bool*[N];
+NQueensBoard::NQueensBoard(int n):N(n),WORDS((n+63)/64){
+	allocateBoard();
+	memset(cells, 0, (size_t)N*WORDS*sizeof(uint64_t));
 	for(int h=0; h<N; h++){
-		board[h] = new bool[N];
-		for(int w=0; w<N; w++){
-			board[h][w] = (w == h);
-		}
+		board[h][h >> 6] |= (uint64_t)1 << (h & 63);
 	}
 	nQueens = N;
 	nErrorsCache = 0;
 	cacheCorrect = false;
+	linesCorrect = false;
+	lastRow1 = lastRow2 = lastCol1 = lastCol2 = 0;
 	calcErrors();
 }
 
-NQueensBoard::NQueensBoard(const NQueensBoard& orig):N(orig.N){ //Copy constructor
-	board = new bool*[N];
-	for(int h=0; h<N; h++){
-		board[h] = new bool[N];
-		for(int w=0; w<N; w++){
-			board[h][w] = orig.board[h][w];
-		}
-	}
-	nQueens = orig.nQueens;
-	nErrorsCache = orig.nErrorsCache;
-	cacheCorrect = orig.cacheCorrect;
+NQueensBoard::NQueensBoard(const NQueensBoard& orig):N(orig.N),WORDS(orig.WORDS){ //Copy constructor
+	allocateBoard();
+	copyBoard(orig);
 }
 
-
-NQueensBoard::~NQueensBoard(){
-	for (int h = 0; h < N; h++){
-		delete [] board[h];
+NQueensBoard& NQueensBoard::operator=(const NQueensBoard& rhs){
+	assert(N == rhs.N); // the storage is reused, so only boards of the same size can be assigned
+	if(this != &rhs){
+		copyBoard(rhs);
 	}
-	delete [] board;
+	return *this;
 }
 
-void NQueensBoard::print() const{
-	//upper line
-	for(int i=0; i< (2*N+3); i++) std::cout << "*";
-	std::cout << std::endl;
+NQueensBoard::~NQueensBoard(){
+	delete [] cells;
+}
 
-	//first separator
-	std::cout << "*";
-	for(int i=0; i< (2*N+1); i++) std::cout << "-";
-	std::cout << "*" << std::endl;
+void NQueensBoard::allocateBoard(){
+	//one block: the N*WORDS words of the rows, the 6N-2 line counters and the N row pointers
+	size_t cellWords = (size_t)N*WORDS;
+	size_t countWords = ((6*(size_t)N-2)*sizeof(int) + sizeof(uint64_t) - 1)/sizeof(uint64_t);
+	size_t pointerWords = ((size_t)N*sizeof(uint64_t*) + sizeof(uint64_t) - 1)/sizeof(uint64_t);
+	cells = new uint64_t[cellWords + countWords + pointerWords];
+	counts = (int*)(cells + cellWords);
+	board = (uint64_t**)(cells + cellWords + countWords);
+	for(int h=0; h<N; h++){
+		board[h] = cells + (size_t)h*WORDS;
+	}
+}
 
+void NQueensBoard::copyBoard(const NQueensBoard& orig){
+	//the cells are copied in one go, the rows keep the order the row swaps gave them
+	memcpy(cells, orig.cells, (size_t)N*WORDS*sizeof(uint64_t));
+	for(int h=0; h<N; h++){
+		board[h] = cells + (orig.board[h] - orig.cells);
+	}
+	nQueens = orig.nQueens;
+	nErrorsCache = orig.nErrorsCache;
+	cacheCorrect = orig.cacheCorrect;
+	//the line counters aren't copied, most copies are changed once and thrown away
+	linesCorrect = false;
+	lastRow1 = lastRow2 = lastCol1 = lastCol2 = 0;
+}
 
+void NQueensBoard::print(std::ostream& output) const{
+	//every line is built first and written with one call
+	std::string border(2*N+3, '*');
+	std::string separator = "*" + std::string(2*N+1, '-') + "*";
+	std::string row = "*|" + std::string(2*N, '|') + "*";
+	output << border << "\n" << separator << "\n";
 	for(int h=0; h<N; h++){
-		std::cout << "*|";
 		for(int w=0; w<N; w++){
-			std::cout << "" << (board[h][w]?"Q":" ") << "|";
+			row[2+2*w] = hasQueen(h, w) ? 'Q' : ' ';
 		}
-		std::cout << "*";
-
-		//loop separator
-		std::cout <<"\n*";
-		for(int i=0; i< (2*N+1); i++) std::cout << "-";
-		std::cout << "*" << std::endl;
+		output << row << "\n" << separator << "\n";
 	}
-
-	//lower line
-	for(int i=0; i< (2*N+3); i++) std::cout << "*";
-	std::cout << "\n\n\n" << std::endl;
+	output << border << "\n\n\n" << std::endl;
 }
 
 void NQueensBoard::setQueen(int h, int w){
 	checkCoords(h-1, w-1);
-	if(!board[h-1][w-1]){
-		board[h-1][w-1] = true;
+	if(!hasQueen(h-1, w-1)){
+		board[h-1][(w-1) >> 6] |= (uint64_t)1 << ((w-1) & 63);
 		nQueens++;
-		cacheCorrect = false;
+		if(linesCorrect){
+			addToLine(counts[h-1], 1);
+			addToLine(counts[N + w-1], 1);
+			addToLine(counts[2*N + h-1+w-1], 1);
+			addToLine(counts[4*N-1 + (h-1)-(w-1)+N-1], 1);
+		}else{
+			cacheCorrect = false;
+		}
 	}
 
 }
 
 void NQueensBoard::unsetQueen(int h, int w){
 	checkCoords(h-1, w-1);
-	if(board[h-1][w-1]){
-		board[h-1][w-1] = false;
+	if(hasQueen(h-1, w-1)){
+		board[h-1][(w-1) >> 6] &= ~((uint64_t)1 << ((w-1) & 63));
 		nQueens--;
-		cacheCorrect = false;
+		if(linesCorrect){
+			addToLine(counts[h-1], -1);
+			addToLine(counts[N + w-1], -1);
+			addToLine(counts[2*N + h-1+w-1], -1);
+			addToLine(counts[4*N-1 + (h-1)-(w-1)+N-1], -1);
+		}else{
+			cacheCorrect = false;
+		}
 	}
 }
 
-bool NQueensBoard::checkCoords(int h, int w){
+bool NQueensBoard::checkCoords(int h, int w) const{
 	assert(h >= 0);
 	assert(h < N);
 	assert(w >= 0);
@@ -91,130 +119,261 @@ bool NQueensBoard::checkCoords(int h, int w){
 	return true;
 }
 
-NQueensBoard* NQueensBoard::returnRandomNeighbour() const{	
-	NQueensBoard* boardcopy = new NQueensBoard(*this);
-	int row1 = rand()%N;
-	int row2 = rand()%N;
-	int col1 = rand()%N;
-	int col2 = rand()%N;
+void NQueensBoard::applySwap(int row1, int row2, int col1, int col2){
+	lastRow1 = row1;
+	lastRow2 = row2;
+	lastCol1 = col1;
+	lastCol2 = col2;
+
+	swapRowsAndColumns(lastRow1, lastRow2, lastCol1, lastCol2);
+	calcErrors();
+}
+
+void NQueensBoard::undoSwap(){
+	//row and column swaps commute and undo themselves
+	swapRowsAndColumns(lastRow1, lastRow2, lastCol1, lastCol2);
+}
+
+//with the line counters only the lines of the queens that move are updated, without them the 
+//board is counted again by the next getErrors()
+void NQueensBoard::swapRowsAndColumns(int row1, int row2, int col1, int col2){
 	if( row1 != row2 ){
-		//std::cout << "Swap row "<< row1+1 << " and " << row2+1 << std::endl;
-		bool* hulp = boardcopy->board[row1];
-		boardcopy->board[row1] = boardcopy->board[row2];
-		boardcopy->board[row2] = hulp;
-		boardcopy->cacheCorrect=false;
+		if(linesCorrect){
+			for(int word=0; word<WORDS; word++){
+				uint64_t bits1 = board[row1][word];
+				uint64_t bits2 = board[row2][word];
+				for(; bits1; bits1 &= bits1-1){
+					moveQueenRow((word << 6) + lowestBit(bits1), row1, row2);
+				}
+				for(; bits2; bits2 &= bits2-1){
+					moveQueenRow((word << 6) + lowestBit(bits2), row2, row1);
+				}
+			}
+		}else{
+			cacheCorrect=false;
+		}
+		uint64_t* hulp = board[row1];
+		board[row1] = board[row2];
+		board[row2] = hulp;
 	}
 
 	if( col1 != col2){
-		//std::cout << "Swap col " << col1+1 << " and " << col2+1 << std::endl;
-		for(int i=0; i<N; i++){
-			bool hulp = boardcopy->board[i][col1];
-			boardcopy->board[i][col1] = boardcopy->board[i][col2];
-			boardcopy->board[i][col2] = hulp;
+		int word1 = col1 >> 6, shift1 = col1 & 63;
+		int word2 = col2 >> 6, shift2 = col2 & 63;
+		if(linesCorrect){
+			for(int i=0; i<N; i++){
+				uint64_t* row = board[i];
+				uint64_t differ = ((row[word1] >> shift1) ^ (row[word2] >> shift2)) & 1;
+				if(differ){
+					if((row[word1] >> shift1) & 1){
+						moveQueenColumn(i, col1, col2);
+					}else{
+						moveQueenColumn(i, col2, col1);
+					}
+					row[word1] ^= differ << shift1;
+					row[word2] ^= differ << shift2;
+				}
+			}
+		}else{
+			//exchanges the two bits of every row without branching, the rows lie WORDS apart in cells
+			for(int i=0; i<N; i++){
+				uint64_t* row = board[i];
+				uint64_t differ = ((row[word1] >> shift1) ^ (row[word2] >> shift2)) & 1;
+				row[word1] ^= differ << shift1;
+				row[word2] ^= differ << shift2;
+			}
+			cacheCorrect=false;
 		}
-		boardcopy->cacheCorrect=false;
 	}
-
-	boardcopy->calcErrors();
-
-	return boardcopy;
 }
 
-void NQueensBoard::calcErrors(){
+void NQueensBoard::calcErrors() const{
 	if(!cacheCorrect){
-		nErrorsCache = 0;
-		for(int i=0; i<N; i++){
-			nErrorsCache += nErrors(nQueensInRow(i));
-			nErrorsCache += nErrors(nQueensInColumn(i));
-		}
-		for(int i=0; i<N+N-2; i++){
-			nErrorsCache += nErrors(nQueensInDiagUp(i));
-			nErrorsCache += nErrors(nQueensInDiagDown(i));
-		}
+		memset(counts, 0, (6*(size_t)N-2)*sizeof(int));
+		countLines(0, N, counts+N);
+		nErrorsCache = sumLineErrors();
+		linesCorrect = true;
 	}
 	cacheCorrect = true;
 }
 
-int NQueensBoard::nQueensInRow(int i){
-	checkCoords(i, 0);
-	int currentNQueens = 0;	for(int w=0; w<N; w++){
-		if(board[i][w]){
-			currentNQueens++;
+void NQueensBoard::countLines(int firstRow, int lastRow, int* lines) const{
+	int* columns = lines;
+	int* diagUp = lines + N; // row+column
+	int* diagDown = diagUp + 2*N-1; // row-column+N-1
+	for(int h=firstRow; h<lastRow; h++){
+		const uint64_t* row = board[h];
+		int inRow = 0;
+		for(int word=0; word<WORDS; word++){
+			uint64_t bits = row[word];
+			inRow += popCount(bits);
+			//queens are sparse, only the set bits are visited
+			while(bits){
+				int w = (word << 6) + lowestBit(bits);
+				columns[w]++;
+				diagUp[h+w]++;
+				diagDown[h-w+N-1]++;
+				bits &= bits-1;
+			}
 		}
+		counts[h] = inRow;
 	}
-	return currentNQueens;
 }
 
-int NQueensBoard::nQueensInColumn(int i){
-	checkCoords(0, i);
-	int currentNQueens = 0;
-	for(int h=0; h<N; h++){
-		if(board[h][i]){
-			currentNQueens++;
-		}
+int NQueensBoard::sumLineErrors() const{
+	int errors = 0;
+	for(int i=0; i<6*N-2; i++){
+		errors += nErrors(counts[i]);
 	}
-	return currentNQueens;
+	return errors;
 }
-int NQueensBoard::nQueensInDiagDown(int i){
-	int currentNQueens = 0;
-	int w;
-	int h;
-	if(i < N){
-		w=0;
-		h=N-1-i;
-	}else{
-		h=0;
-		w=i-(N-1);
+
+//one parallel loop over blocks: the calling thread and the tasks submitted to the pool take 
+//blocks until none are left, the caller then only waits for the blocks taken by the tasks, not 
+//for everything in the pool (so a task of the pool can run one without waiting for itself). 
+//The tasks share the loop, a task that starts after it has finished finds no blocks left.
+class BlockLoop{
+
+public:
+	BlockLoop(int blocks, const std::function<void(int)>& work):blocks(blocks),nextBlock(0),finishedBlocks(0),work(work){
 	}
-	while(w<N && h<N){
-		if(board[h][w]){
-			currentNQueens++;
+
+	//runs blocks until none are left
+	void run(){
+		int block;
+		while((block = nextBlock++) < blocks){
+			work(block);
+			std::lock_guard<std::mutex> lock(mutex);
+			if(++finishedBlocks == blocks){
+				finished.notify_all();
+			}
 		}
-		w++;
-		h++;
-	}
-	return currentNQueens;
-}
-int NQueensBoard::nQueensInDiagUp(int i){
-	int currentNQueens = 0;
-	int w;
-	int h;
-	if(i < N){
-		w=0;
-		h=i;
-	}else{
-		h=N-1;
-		w=i-(N-1);
 	}
-	while(w<N && h>=0){
-		if(board[h][w]){
-			currentNQueens++;
+
+	//blocks until every block has been run
+	void wait(){
+		std::unique_lock<std::mutex> lock(mutex);
+		while(finishedBlocks < blocks){
+			finished.wait(lock);
 		}
-		w++;
-		h--;
 	}
-	return currentNQueens;
+
+private:
+	int blocks;
+	std::atomic<int> nextBlock;
+	int finishedBlocks;
+	std::function<void(int)> work;
+	std::mutex mutex;
+	std::condition_variable finished;
+};
+
+static void runBlocks(ThreadPool* pool, int blocks, const std::function<void(int)>& work){
+	std::shared_ptr<BlockLoop> loop = std::make_shared<BlockLoop>(blocks, work);
+	for(int b=1; b<blocks; b++){
+		pool->submit([loop](){
+			loop->run();
+		});
+	}
+	loop->run();
+	loop->wait();
+}
+
+int NQueensBoard::recountErrors(ThreadPool* pool) const{
+	cacheCorrect = false;
+	int blocks = pool != 0 ? (int)pool->size() : 1;
+	if(blocks < 2 || N < blocks){
+		calcErrors();
+		return nErrorsCache;
+	}
+
+	//every block of rows gets counters of its own, the rows of a block are walked in memory 
+	//order and their diagonals are neighbours in the counters
+	int nLines = 5*N-2;
+	std::vector<int> blockLines((size_t)blocks*nLines, 0);
+	int* perBlock = &blockLines[0];
+	runBlocks(pool, blocks, [this, blocks, nLines, perBlock](int b){
+		int firstRow = (int)((long long)N*b/blocks);
+		int lastRow = (int)((long long)N*(b+1)/blocks);
+		countLines(firstRow, lastRow, perBlock + (size_t)b*nLines);
+	});
+
+	//every block sums a slice of the lines over all blocks
+	int* lines = counts+N;
+	runBlocks(pool, blocks, [lines, perBlock, blocks, nLines](int b){
+		int first = (int)((long long)nLines*b/blocks);
+		int last = (int)((long long)nLines*(b+1)/blocks);
+		for(int i=first; i<last; i++){
+			int sum = 0;
+			for(int block=0; block<blocks; block++){
+				sum += perBlock[(size_t)block*nLines + i];
+			}
+			lines[i] = sum;
+		}
+	});
+
+	nErrorsCache = sumLineErrors();
+	linesCorrect = true;
+	cacheCorrect = true;
+	return nErrorsCache;
 }
 
-int NQueensBoard::nErrors(int nQueens){
-	int nErrors = nQueens-1;
-	if(nErrors>=0)
-		return nErrors;
-	else
-		return 0;
+bool NQueensBoard::getQueenColumns(std::vector<int>& columns) const{
+	columns.assign(N, -1);
+	for(int h=0; h<N; h++){
+		for(int word=0; word<WORDS; word++){
+			uint64_t bits = board[h][word];
+			if(bits == 0){
+				continue;
+			}
+			if(columns[h] != -1 || (bits & (bits-1)) != 0){
+				return false;
+			}
+			columns[h] = (word << 6) + lowestBit(bits);
+		}
+	}
+	return true;
 }
 
 int NQueensBoard::getErrors() const{
-	assert(cacheCorrect);
+	calcErrors();
 	return nErrorsCache;
 }
 
 std::ostream& operator<<(std::ostream& output, const NQueensBoard& nqb){
-	std::cout << "Errors: " << nqb.getErrors() << std::endl;
-	nqb.print();
+	output << "Errors: " << nqb.getErrors() << std::endl;
+	if(nqb.N <= 100){
+		nqb.print(output);
+	}else{
+		output << "(" << nqb.N << " queens, too large to print, see writeQueenPositions())" << std::endl;
+	}
 	return output;
 }
 
+void writeCheckpoint(CheckpointWriter& writer, const NQueensBoard& board){
+	writer.write(board.N);
+	writer.write(board.nQueens);
+	writer.write(board.nErrorsCache);
+	writer.write(board.cacheCorrect);
+	for(int h=0; h<board.N; h++){
+		writer.writeBytes(board.board[h], board.WORDS*sizeof(uint64_t));
+	}
+}
+
+bool readCheckpoint(CheckpointReader& reader, NQueensBoard& board){
+	int n = 0;
+	if(!reader.read(n) || n != board.N){
+		return false;
+	}
+	reader.read(board.nQueens);
+	reader.read(board.nErrorsCache);
+	reader.read(board.cacheCorrect);
+	board.linesCorrect = false;
+	for(int h=0; h<board.N; h++){
+		reader.readBytes(board.board[h], board.WORDS*sizeof(uint64_t));
+	}
+	return reader.good();
+}
+
 int NQueensBoard::objects;
 
 //int main(){
@@ -1,44 +1,166 @@
+#ifndef __N_QUEENS_BOARD_H
+#define __N_QUEENS_BOARD_H
+
 #include <iostream>
 #include <assert.h>
 #include <vector>
 #include <stdlib.h>
 #include <time.h>
+#include <cstring>	// needed for memcpy
+#include <stdint.h>
+#include "../checkpoint.h"
+
+class ThreadPool;
+
+/******************************************************************//**
+
+   NQueensBoard
+
+   General N-Queens board, any square can hold a queen (see setQueen).
+   The squares are bit-packed: every row is a run of (N+63)/64 64 bit
+   words, all rows and the queen counters of every line are allocated
+   in one block. Rows are counted with popcount, columns and diagonals
+   by walking the set bits, so a count takes O(N*N/64 + queens).
+
+   Once counted, the line counters are kept up to date: setQueen and
+   unsetQueen only change the row, column and two diagonals of the
+   square, a swap only the lines of the queens it moves. A copy
+   starts without counters and counts again at its first change.
+   recountErrors() counts the whole board on a ThreadPool.
+
+***************************************************************************/
 
 class NQueensBoard{
 	friend std::ostream& operator<<(std::ostream& output, const NQueensBoard& nqb);
+	friend void writeCheckpoint(CheckpointWriter& writer, const NQueensBoard& board);
+	friend bool readCheckpoint(CheckpointReader& reader, NQueensBoard& board);
 
 public:
 	NQueensBoard(int n);
 	~NQueensBoard();
 	NQueensBoard(const NQueensBoard& board);
-	//NQueensBoard& operator=(const NQueensBoard &rhs);
+	//only for boards of the same size, reuses the storage (see SolutionPool)
+	NQueensBoard& operator=(const NQueensBoard &rhs);
 
-	void print() const;
+	void print(std::ostream& output) const;
 	void setQueen(int h, int w);
 	void unsetQueen(int h, int w);
-	NQueensBoard* returnRandomNeighbour() const;
+	template <class RNG> NQueensBoard* returnRandomNeighbour(RNG& rng) const;
+	//in-place variant of returnRandomNeighbour, the last swap can be reverted with undoSwap
+	template <class RNG> void applyRandomSwap(RNG& rng);
+	//swaps rows row1/row2 and columns col1/col2 (0 based) and recalculates the errors
+	void applySwap(int row1, int row2, int col1, int col2);
+	void undoSwap();
 
+	//counts the errors when they aren't known
 	int getErrors() const;
 
+	/**
+		Column (0 based) of the queen of every row, -1 for a row without a queen, e.g. for 
+		writeQueenPositions() (see queen_positions.h), O(N*N/64)
+			@return false when a row has more than one queen
+	*/
+	bool getQueenColumns(std::vector<int>& columns) const;
+
+	/**
+		Counts all lines of the board again, e.g. to verify the kept counters or after 
+		building a large board, the result is the same as that of a sequential count
+			@param pool The rows are split in one block per thread of the pool, each block is 
+						counted into counters of its own and the counters are summed in parallel, 
+						the calling thread takes blocks too and only waits for the blocks of this 
+						count, so it may be called from a task of the pool, 0 counts on the calling 
+						thread
+			@return The errors
+	*/
+	int recountErrors(ThreadPool* pool = 0) const;
+
 	static int objects;
 
 private:
 	const int N;
+	const int WORDS; // 64 bit words per row
 	int nQueens;
-	int nErrorsCache;
-	bool** board;
-	bool cacheCorrect;
+	mutable int nErrorsCache;
+	uint64_t** board; // row pointers into cells, row swaps only swap the pointers
+	uint64_t* cells; // the N rows of WORDS words, allocated in one block with board and counts
+	int* counts; // queens per line: rows, columns, diagonals row+column, diagonals row-column+N-1
+	mutable bool cacheCorrect; // nErrorsCache is right
+	mutable bool linesCorrect; // counts is right (and so is nErrorsCache)
+
+	//last swap done by applyRandomSwap, a swap undoes itself
+	int lastRow1, lastRow2, lastCol1, lastCol2;
+
+	void allocateBoard();
+	void copyBoard(const NQueensBoard& orig);
+	void swapRowsAndColumns(int row1, int row2, int col1, int col2);
+	bool checkCoords(int h, int w) const;
+
+	bool hasQueen(int h, int w) const;
+
+	static int nErrors(int nQueens);
+
+	void calcErrors() const;
+	//counts the columns and diagonals of rows [firstRow, lastRow) into lines (laid out like counts 
+	//without the rows), the rows straight into counts
+	void countLines(int firstRow, int lastRow, int* lines) const;
+	int sumLineErrors() const;
+
+	//adds change queens to a line and keeps nErrorsCache up to date
+	void addToLine(int& count, int change);
+	void moveQueenRow(int w, int fromRow, int toRow);
+	void moveQueenColumn(int h, int fromColumn, int toColumn);
+
+};
+
+//checkpoint hooks (see checkpoint.h), a board can only be read into a board of the same size
+void writeCheckpoint(CheckpointWriter& writer, const NQueensBoard& board);
+bool readCheckpoint(CheckpointReader& reader, NQueensBoard& board);
+
+template <class RNG>
+NQueensBoard* NQueensBoard::returnRandomNeighbour(RNG& rng) const{
+	NQueensBoard* boardcopy = new NQueensBoard(*this);
+	boardcopy->applyRandomSwap(rng);
+	return boardcopy;
+}
+
+template <class RNG>
+void NQueensBoard::applyRandomSwap(RNG& rng){
+	int row1 = rng.nextInt(N);
+	int row2 = rng.nextInt(N);
+	int col1 = rng.nextInt(N);
+	int col2 = rng.nextInt(N);
+	applySwap(row1, row2, col1, col2);
+}
 
-	bool checkCoords(int h, int w);
+inline bool NQueensBoard::hasQueen(int h, int w) const{
+	return (board[h][w >> 6] >> (w & 63)) & 1;
+}
 
+inline void NQueensBoard::addToLine(int& count, int change){
+	nErrorsCache += nErrors(count+change) - nErrors(count);
+	count += change;
+}
 
-	int nQueensInRow(int i);
-	int nQueensInColumn(int i);
-	int nQueensInDiagDown(int i);
-	int nQueensInDiagUp(int i);
+inline void NQueensBoard::moveQueenRow(int w, int fromRow, int toRow){
+	addToLine(counts[fromRow], -1);
+	addToLine(counts[2*N + fromRow+w], -1);
+	addToLine(counts[4*N-1 + fromRow-w+N-1], -1);
+	addToLine(counts[toRow], 1);
+	addToLine(counts[2*N + toRow+w], 1);
+	addToLine(counts[4*N-1 + toRow-w+N-1], 1);
+}
 
-	int nErrors(int nQueens);
+inline void NQueensBoard::moveQueenColumn(int h, int fromColumn, int toColumn){
+	addToLine(counts[N + fromColumn], -1);
+	addToLine(counts[2*N + h+fromColumn], -1);
+	addToLine(counts[4*N-1 + h-fromColumn+N-1], -1);
+	addToLine(counts[N + toColumn], 1);
+	addToLine(counts[2*N + h+toColumn], 1);
+	addToLine(counts[4*N-1 + h-toColumn+N-1], 1);
+}
 
-	void calcErrors();
+inline int NQueensBoard::nErrors(int nQueens){
+	return nQueens > 1 ? nQueens-1 : 0;
+}
 
-};
\ No newline at end of file
+#endif
\ No newline at end of file
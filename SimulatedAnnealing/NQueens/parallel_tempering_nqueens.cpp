@@ -0,0 +1,40 @@
+#include "../parallel_tempering.h"
+#include "simulated_annealing_nqueens.h"
+#include <ctime>	// needed for random seed
+
+/******************************************************************//**
+
+   Example of the use of the ParallelTempering class
+   Solves the N-Queens problem with a ladder of SimulatedAnnealingNQueens
+   replicas that search in parallel
+
+***************************************************************************/
+
+int main(int argc, char *argv[]){
+	const int N = 100;
+	const int REPLICAS = 8;
+	uint64_t seed = (uint64_t)time(0);
+
+	NQueensBoard startSolution(N);
+	std::vector<SimulatedAnnealing<NQueensBoard, int>*> replicas;
+	for(int i=0; i<REPLICAS; i++){
+		// every replica gets its own random stream
+		replicas.push_back(new SimulatedAnnealingNQueens<>(startSolution, 0, 1, 1, 1, seed+i));
+	}
+
+	std::vector<double> temps = ParallelTempering<NQueensBoard, int>::geometricLadder(0.2, 5, REPLICAS);
+	ParallelTempering<NQueensBoard, int> pt(replicas, temps, 1000, 0, seed+REPLICAS);
+
+	std::clock_t start = std::clock();
+	bool solved = pt.run(100000);
+
+	std::cout << (solved ? "Solution found" : "No solution found") << " in "
+		<< (std::clock() - start)/(double)CLOCKS_PER_SEC << "s cpu time" << std::endl << std::endl;
+	pt.printSwapAcceptanceRates(std::cout);
+	std::cout << std::endl << pt.getBestReplica()->getSolution() << std::endl;
+
+	for(int i=0; i<REPLICAS; i++){
+		delete replicas[i];
+	}
+	return 0;
+}
@@ -0,0 +1,89 @@
+#include "permutation_board.h"
+#include <string>
+
+PermutationBoard::PermutationBoard(int n):N(n),columns(n),diagUp(2*n-1),diagDown(2*n-1),errors(0),lastRow1(0),lastRow2(0),version(0),inConflictRows(n){
+	assert(n > 0);
+	for(int i=0; i<N; i++){
+		columns[i] = i;
+	}
+	countDiagonals();
+}
+
+void PermutationBoard::countDiagonals(){
+	for(int i=0; i<2*N-1; i++){
+		diagUp[i] = 0;
+		diagDown[i] = 0;
+	}
+	for(int row=0; row<N; row++){
+		diagUp[row+columns[row]]++;
+		diagDown[row-columns[row]+N-1]++;
+	}
+	errors = 0;
+	for(int i=0; i<2*N-1; i++){
+		errors += lineErrors(diagUp[i]);
+		errors += lineErrors(diagDown[i]);
+	}
+	rebuildConflicts();
+	version++;
+}
+
+void PermutationBoard::rebuildConflicts() const{
+	conflictRows.clear();
+	for(int row=0; row<N; row++){
+		inConflictRows[row] = inConflict(row);
+		if(inConflictRows[row]){
+			conflictRows.push_back(row);
+		}
+	}
+}
+
+void PermutationBoard::print(std::ostream& output) const{
+	//every line is built first and written with one call
+	std::string border(2*N+3, '*');
+	std::string row = "*|" + std::string(2*N, '|') + "*";
+	output << border << "\n";
+	for(int h=0; h<N; h++){
+		for(int w=0; w<N; w++){
+			row[2+2*w] = columns[h] == w ? 'Q' : ' ';
+		}
+		output << row << "\n";
+	}
+	output << border << "\n\n\n" << std::endl;
+}
+
+std::ostream& operator<<(std::ostream& output, const PermutationBoard& board){
+	output << "Errors: " << board.getErrors() << std::endl;
+	if(board.N <= 100){
+		board.print(output);
+	}else{
+		output << "(" << board.N << " queens, too large to print, see writeQueenPositions())" << std::endl;
+	}
+	return output;
+}
+
+void writeCheckpoint(CheckpointWriter& writer, const PermutationBoard& board){
+	writer.write(board.N);
+	writer.writeBytes(&board.columns[0], board.N*sizeof(int));
+}
+
+bool readCheckpoint(CheckpointReader& reader, PermutationBoard& board){
+	int n = 0;
+	if(!reader.read(n) || n != board.N){
+		return false;
+	}
+	//the board is only changed once the columns are known to be a permutation
+	std::vector<int> columns(board.N);
+	if(!reader.readBytes(&columns[0], board.N*sizeof(int))){
+		return false;
+	}
+	std::vector<char> seen(board.N, 0);
+	for(int row=0; row<board.N; row++){
+		if(columns[row] < 0 || columns[row] >= board.N || seen[columns[row]]){
+			return false;
+		}
+		seen[columns[row]] = 1;
+	}
+	board.columns.swap(columns);
+	board.countDiagonals();
+	return true;
+}
@@ -0,0 +1,243 @@
+#ifndef __PERMUTATION_BOARD_H
+#define __PERMUTATION_BOARD_H
+
+#include <iostream>
+#include <assert.h>
+#include <vector>
+#include "../checkpoint.h"
+
+/******************************************************************//**
+
+   PermutationBoard
+
+   N-Queens board with one queen per row and per column: the queen
+   of row r stands in column columns[r]. Rows and columns never
+   conflict, so only the diagonals are counted, every diagonal keeps
+   its number of queens. Errors are counted like NQueensBoard does
+   (a line with k queens has k-1 errors).
+
+   The neighbour move swaps the columns of two queens, the change in
+   errors it causes is known in O(1) from the diagonal counters and
+   the board takes O(N) memory, so boards of millions of queens can
+   be annealed.
+
+   The board also keeps a set of the rows whose queen is in conflict
+   (shares a diagonal), so moves can be aimed at them. A queen that a
+   swap puts in conflict is added to the set. Rows that are no longer
+   in conflict are only taken out when they're drawn, and when the
+   set runs out while there are still errors it is rebuilt in O(N).
+
+***************************************************************************/
+
+class PermutationBoard{
+	friend std::ostream& operator<<(std::ostream& output, const PermutationBoard& board);
+	friend void writeCheckpoint(CheckpointWriter& writer, const PermutationBoard& board);
+	friend bool readCheckpoint(CheckpointReader& reader, PermutationBoard& board);
+
+public:
+	//all queens on the main diagonal, like NQueensBoard(n)
+	PermutationBoard(int n);
+
+	//puts the queens in a random permutation of the columns
+	template <class RNG> void shuffle(RNG& rng);
+
+	/**
+		@return The change in errors swapping the columns of the queens of both rows would
+				cause, the board isn't changed
+	*/
+	int swapDelta(int row1, int row2) const;
+
+	//swaps the columns of the queens of both rows
+	void applySwap(int row1, int row2);
+
+	//in-place variant of a random neighbour, the last swap can be reverted with undoSwap
+	template <class RNG> void applyRandomSwap(RNG& rng);
+	void undoSwap();
+
+	int getErrors() const;
+	int getSize() const;
+	int getColumn(int row) const;
+	//column of the queen of every row, e.g. for writeQueenPositions() (see queen_positions.h)
+	const std::vector<int>& getColumns() const;
+
+	//whether or not the queen of the row shares a diagonal with another queen
+	bool inConflict(int row) const;
+
+	/**
+		@return The number of changes made to the board so far, together with the address of 
+				the board it tells whether a board changed since it was last seen (e.g. by a 
+				SwapMoveTable)
+	*/
+	long getVersion() const;
+
+	/**
+		@return A random row whose queen is in conflict, a uniformly random row when there are 
+				no errors. The rows in the set are equally likely, the set can miss conflicted 
+				queens that didn't move since the last rebuild.
+	*/
+	template <class RNG> int randomConflictRow(RNG& rng) const;
+
+	void print(std::ostream& output) const;
+
+private:
+	int N;
+	std::vector<int> columns; // column of the queen of each row
+	std::vector<int> diagUp; // queens per diagonal row+column
+	std::vector<int> diagDown; // queens per diagonal row-column+N-1
+	int errors;
+	int lastRow1, lastRow2;
+	long version; // see getVersion()
+	mutable std::vector<int> conflictRows; // rows that were in conflict, see randomConflictRow()
+	mutable std::vector<char> inConflictRows; // whether or not a row is in conflictRows
+
+	void countDiagonals();
+	void rebuildConflicts() const;
+	void noteConflict(int row);
+
+	static int lineErrors(int nQueens);
+	static int lineDelta(const std::vector<int>& counts, int removed1, int removed2, int added1, int added2);
+
+};
+
+//checkpoint hooks (see checkpoint.h), a board can only be read into a board of the same size
+void writeCheckpoint(CheckpointWriter& writer, const PermutationBoard& board);
+bool readCheckpoint(CheckpointReader& reader, PermutationBoard& board);
+
+template <class RNG>
+void PermutationBoard::shuffle(RNG& rng){
+	for(int i=N-1; i>0; i--){
+		int j = rng.nextInt(i+1);
+		int hulp = columns[i];
+		columns[i] = columns[j];
+		columns[j] = hulp;
+	}
+	countDiagonals();
+}
+
+template <class RNG>
+void PermutationBoard::applyRandomSwap(RNG& rng){
+	int row1 = rng.nextInt(N);
+	int row2 = rng.nextInt(N);
+	applySwap(row1, row2);
+}
+
+template <class RNG>
+int PermutationBoard::randomConflictRow(RNG& rng) const{
+	if(errors == 0){
+		return rng.nextInt(N);
+	}
+	while(true){
+		if(conflictRows.empty()){
+			rebuildConflicts();
+		}
+		int index = rng.nextInt((int)conflictRows.size());
+		int row = conflictRows[index];
+		if(inConflict(row)){
+			return row;
+		}
+		//lazy deletion of a row that left the conflicts
+		inConflictRows[row] = 0;
+		conflictRows[index] = conflictRows.back();
+		conflictRows.pop_back();
+	}
+}
+
+inline int PermutationBoard::lineErrors(int nQueens){
+	return nQueens > 1 ? nQueens-1 : 0;
+}
+
+//change in errors of one family of diagonals when the queens on removed1 and removed2 move to
+//added1 and added2, indices that occur more than once are merged first
+inline int PermutationBoard::lineDelta(const std::vector<int>& counts, int removed1, int removed2, int added1, int added2){
+	int index[4] = {removed1, removed2, added1, added2};
+	int change[4] = {-1, -1, 1, 1};
+	int delta = 0;
+	for(int i=0; i<4; i++){
+		if(change[i] == 0){
+			continue;
+		}
+		for(int j=i+1; j<4; j++){
+			if(index[j] == index[i]){
+				change[i] += change[j];
+				change[j] = 0;
+			}
+		}
+		int count = counts[index[i]];
+		delta += lineErrors(count+change[i]) - lineErrors(count);
+	}
+	return delta;
+}
+
+inline int PermutationBoard::swapDelta(int row1, int row2) const{
+	if(row1 == row2){
+		return 0;
+	}
+	int col1 = columns[row1];
+	int col2 = columns[row2];
+	return lineDelta(diagUp, row1+col1, row2+col2, row1+col2, row2+col1)
+		+ lineDelta(diagDown, row1-col1+N-1, row2-col2+N-1, row1-col2+N-1, row2-col1+N-1);
+}
+
+inline void PermutationBoard::applySwap(int row1, int row2){
+	lastRow1 = row1;
+	lastRow2 = row2;
+	if(row1 == row2){
+		return;
+	}
+	errors += swapDelta(row1, row2);
+	int col1 = columns[row1];
+	int col2 = columns[row2];
+	diagUp[row1+col1]--;
+	diagUp[row2+col2]--;
+	diagDown[row1-col1+N-1]--;
+	diagDown[row2-col2+N-1]--;
+	diagUp[row1+col2]++;
+	diagUp[row2+col1]++;
+	diagDown[row1-col2+N-1]++;
+	diagDown[row2-col1+N-1]++;
+	columns[row1] = col2;
+	columns[row2] = col1;
+	version++;
+	noteConflict(row1);
+	noteConflict(row2);
+}
+
+inline void PermutationBoard::noteConflict(int row){
+	if(!inConflictRows[row] && inConflict(row)){
+		inConflictRows[row] = 1;
+		conflictRows.push_back(row);
+	}
+}
+
+inline bool PermutationBoard::inConflict(int row) const{
+	int column = columns[row];
+	return diagUp[row+column] > 1 || diagDown[row-column+N-1] > 1;
+}
+
+inline void PermutationBoard::undoSwap(){
+	//a swap undoes itself
+	applySwap(lastRow1, lastRow2);
+}
+
+inline int PermutationBoard::getErrors() const{
+	return errors;
+}
+
+inline int PermutationBoard::getSize() const{
+	return N;
+}
+
+inline int PermutationBoard::getColumn(int row) const{
+	assert(row >= 0 && row < N);
+	return columns[row];
+}
+
+inline const std::vector<int>& PermutationBoard::getColumns() const{
+	return columns;
+}
+
+inline long PermutationBoard::getVersion() const{
+	return version;
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "simulated_annealing_permutation_nqueens.h"
+#include "queen_positions.h"
+#include <ctime>	// needed for random seed
+#include <cstdlib>	// needed for atoi
+#include <chrono>
+
+/******************************************************************//**
+
+   Solves N-Queens for large N on a PermutationBoard
+
+   Usage: permutation_nqueens [N [seconds [file]]], by default a
+   million queens and at most 10 minutes. With a file the queen
+   positions of the result are written to it (see queen_positions.h)
+   and checked by reading them back.
+
+***************************************************************************/
+
+int main(int argc, char *argv[]){
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+	double seconds = argc > 2 ? atof(argv[2]) : 600;
+	uint64_t seed = (uint64_t)time(0);
+
+	Xoshiro256 rng(seed);
+	PermutationBoard startSolution(n);
+	startSolution.shuffle(rng);
+	std::cout << "N=" << n << ", errors of the random start: " << startSolution.getErrors() << std::endl;
+
+	//moves change the errors by at most 4, so temperatures around 1 already make most uphill
+	//moves unlikely, the search is mostly spent close to 0
+	StaticSimulatedAnnealingPermutationNQueens<> sapnq(startSolution, 0, 1, 1, 1 - 1.0/n, seed);
+	//moves start at queens in conflict, the last errors are removed by min-conflicts
+	sapnq.setConflictMoves(true);
+	sapnq.setPolishTemp(0.1);
+
+	//solve(options) keeps the best board, early on improvements and worsenings alternate and
+	//every one of them would copy the whole board, the search ends at its lowest temperature
+	//so the current board is good enough here
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	double elapsed = 0;
+	sapnq.evaluateSolution();
+	while(!sapnq.reachedPrecision()){
+		sapnq.step();
+		sapnq.coolDown();
+		if((sapnq.getIteration() & 0xFFFFF) == 0){
+			elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			std::cout << "Iteration " << sapnq.getIteration() << " Temp: " << sapnq.getTemp() << " Errors: " << sapnq.getDistance() << std::endl;
+			if(elapsed > seconds){
+				break;
+			}
+		}
+	}
+	elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "Errors: " << sapnq.getDistance() << " after " << sapnq.getIteration() << " iterations in "
+		<< elapsed << "s" << std::endl;
+
+	if(argc > 3){
+		start = std::chrono::steady_clock::now();
+		if(!writeQueenPositions(argv[3], sapnq.getSolution().getColumns())){
+			std::cout << "Could not write " << argv[3] << std::endl;
+			return 1;
+		}
+		long long errors = verifyQueenPositions(argv[3]);
+		elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "Wrote " << argv[3] << ", errors read back: " << errors << " (" << elapsed << "s)" << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,179 @@
+#include "queen_positions.h"
+#include <cstdio>	// needed for the file functions
+#include <cctype>	// needed for isspace
+
+static const size_t BUFFER_SIZE = 1 << 16;
+
+//writes the buffer to the file when it's (nearly) full or when last is true
+static bool flushBuffer(FILE* file, std::vector<char>& buffer, bool last){
+	if(buffer.empty() || (!last && buffer.size() < BUFFER_SIZE - 16)){
+		return true;
+	}
+	bool written = fwrite(&buffer[0], 1, buffer.size(), file) == buffer.size();
+	buffer.clear();
+	return written;
+}
+
+static void putUint32(std::vector<char>& bytes, uint32_t value){
+	bytes.push_back((char)(value & 0xFF));
+	bytes.push_back((char)((value >> 8) & 0xFF));
+	bytes.push_back((char)((value >> 16) & 0xFF));
+	bytes.push_back((char)((value >> 24) & 0xFF));
+}
+
+static uint32_t getUint32(const unsigned char* bytes){
+	return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+//appends value and a newline
+static void putLine(std::vector<char>& text, int value){
+	char digits[12];
+	int n = 0;
+	bool negative = value < 0;
+	unsigned int magnitude = negative ? 0u - (unsigned int)value : (unsigned int)value;
+	do{
+		digits[n++] = (char)('0' + magnitude % 10);
+		magnitude /= 10;
+	}while(magnitude > 0);
+	if(negative){
+		text.push_back('-');
+	}
+	while(n > 0){
+		text.push_back(digits[--n]);
+	}
+	text.push_back('\n');
+}
+
+static bool readBinary(FILE* file, std::vector<int>& columns){
+	unsigned char header[4];
+	if(fread(header, 1, 4, file) != 4){
+		return false;
+	}
+	uint32_t n = getUint32(header);
+	if(n > (uint32_t)0x7FFFFFFF){
+		return false;
+	}
+	//the columns grow with every block read, so a damaged count can't allocate more than the file holds
+	columns.clear();
+	std::vector<unsigned char> block(BUFFER_SIZE);
+	size_t done = 0;
+	while(done < n){
+		size_t count = n-done < BUFFER_SIZE/4 ? n-done : BUFFER_SIZE/4;
+		if(fread(&block[0], 4, count, file) != count){
+			return false;
+		}
+		columns.resize(done+count);
+		for(size_t i=0; i<count; i++){
+			columns[done+i] = (int)(int32_t)getUint32(&block[4*i]);
+		}
+		done += count;
+	}
+	return fgetc(file) == EOF;
+}
+
+static bool readText(FILE* file, std::vector<int>& columns){
+	long n;
+	if(fscanf(file, "%ld", &n) != 1 || n < 0 || n > 0x7FFFFFFF){
+		return false;
+	}
+	columns.clear();
+	for(long i=0; i<n; i++){
+		int column;
+		if(fscanf(file, "%d", &column) != 1){
+			return false;
+		}
+		columns.push_back(column);
+	}
+	//like the binary format, nothing but white space may follow the columns
+	int c;
+	do{
+		c = fgetc(file);
+	}while(c != EOF && isspace(c));
+	return c == EOF;
+}
+
+
+bool writeQueenPositions(const std::string& path, const std::vector<int>& columns, QueenPositionFormat format){
+	std::string temporary = path + ".tmp";
+	FILE* file = fopen(temporary.c_str(), "wb");
+	if(file == 0){
+		return false;
+	}
+	std::vector<char> buffer;
+	buffer.reserve(BUFFER_SIZE);
+	bool written = true;
+	if(format == QUEENS_BINARY){
+		putUint32(buffer, QUEEN_POSITIONS_MAGIC);
+		putUint32(buffer, (uint32_t)columns.size());
+		for(size_t i=0; i<columns.size(); i++){
+			putUint32(buffer, (uint32_t)columns[i]);
+			written = flushBuffer(file, buffer, false) && written;
+		}
+	}else{
+		putLine(buffer, (int)columns.size());
+		for(size_t i=0; i<columns.size(); i++){
+			putLine(buffer, columns[i]);
+			written = flushBuffer(file, buffer, false) && written;
+		}
+	}
+	written = flushBuffer(file, buffer, true) && written;
+	written = fflush(file) == 0 && written;
+	written = fclose(file) == 0 && written;
+	if(!written){
+		remove(temporary.c_str());
+		return false;
+	}
+#ifdef _WIN32
+	remove(path.c_str()); // rename doesn't replace existing files on windows
+#endif
+	return rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+bool readQueenPositions(const std::string& path, std::vector<int>& columns){
+	FILE* file = fopen(path.c_str(), "rb");
+	if(file == 0){
+		return false;
+	}
+	setvbuf(file, 0, _IOFBF, BUFFER_SIZE);
+	unsigned char magic[4];
+	bool ok;
+	if(fread(magic, 1, 4, file) == 4 && getUint32(magic) == QUEEN_POSITIONS_MAGIC){
+		ok = readBinary(file, columns);
+	}else{
+		rewind(file);
+		ok = readText(file, columns);
+	}
+	fclose(file);
+	return ok;
+}
+
+long long scoreQueenPositions(const std::vector<int>& columns){
+	int n = (int)columns.size();
+	//rows hold at most one queen, so only columns and diagonals can have errors
+	std::vector<int> inColumn(n, 0);
+	std::vector<int> diagUp(n > 0 ? 2*n-1 : 0, 0); // row+column
+	std::vector<int> diagDown(n > 0 ? 2*n-1 : 0, 0); // row-column+N-1
+	long long errors = 0;
+	for(int row=0; row<n; row++){
+		int column = columns[row];
+		if(column == -1){
+			continue;
+		}
+		if(column < -1 || column >= n){
+			return -1;
+		}
+		//the k-th queen on a line adds an error from the second one on
+		errors += inColumn[column]++ > 0;
+		errors += diagUp[row+column]++ > 0;
+		errors += diagDown[row-column+n-1]++ > 0;
+	}
+	return errors;
+}
+
+long long verifyQueenPositions(const std::string& path){
+	std::vector<int> columns;
+	if(!readQueenPositions(path, columns)){
+		return -1;
+	}
+	return scoreQueenPositions(columns);
+}
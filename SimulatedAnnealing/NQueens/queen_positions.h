@@ -0,0 +1,58 @@
+#ifndef __QUEEN_POSITIONS_H
+#define __QUEEN_POSITIONS_H
+
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+/******************************************************************//**
+
+   Queen positions
+
+   Writes and reads N-Queens solutions as the column of the queen of
+   every row (0 based, -1 for a row without a queen), O(N) instead of
+   the O(N*N) grid operator<< prints. Two formats:
+   - QUEENS_TEXT: N on the first line, then one column per line
+   - QUEENS_BINARY: "NQP1", N and the N columns as 32 bit little
+     endian integers (-1 as 0xFFFFFFFF), the same on every machine
+   The files are written and read through a buffer of 64 KiB.
+
+   scoreQueenPositions() counts the errors of the positions in O(N)
+   the way the boards do (a line with k queens has k-1 errors), so a
+   written solution can be checked without a board.
+
+***************************************************************************/
+
+enum QueenPositionFormat{
+	QUEENS_TEXT,
+	QUEENS_BINARY
+};
+
+//first bytes of a binary queen position file, "NQP1"
+const uint32_t QUEEN_POSITIONS_MAGIC = 0x3150514E;
+
+/**
+	Writes the positions to a temporary file next to path which then replaces path
+		@return Whether or not the file was written
+*/
+bool writeQueenPositions(const std::string& path, const std::vector<int>& columns, QueenPositionFormat format = QUEENS_BINARY);
+
+/**
+	Reads a file of either format (told apart by its first bytes)
+		@return false when the file can't be read or isn't a queen position file, also when it 
+				holds fewer or more columns than its N (white space after a text file is fine)
+*/
+bool readQueenPositions(const std::string& path, std::vector<int>& columns);
+
+/**
+	@return The errors of the positions, -1 when a column is outside [-1, N)
+*/
+long long scoreQueenPositions(const std::vector<int>& columns);
+
+/**
+	Reads a file and scores it
+		@return The errors, -1 when the file can't be read or holds invalid positions
+*/
+long long verifyQueenPositions(const std::string& path);
+
+#endif
@@ -1,54 +1,22 @@
-#include "../simulated_annealing.h"
-#include "n_queens_board.h"
-#include <cstdlib>	// needed for random
+#include "simulated_annealing_nqueens.h"
 #include <ctime>	// needed for random seed
 
 #define _CRTDBG_MAP_ALLOC
 #include <stdlib.h>
 #include <crtdbg.h>
 
-class SimulatedAnnealingNQueens:public SimulatedAnnealing<NQueensBoard, int>{
-public:
-	
-	NQueensBoard* giveRandomNeighbour (const NQueensBoard& lastSolution) const;
-
-	double calcDistanceToTarget (const NQueensBoard& solution) const;
-
-	void printStatus (const NQueensBoard& solution, double temp);
-
-	SimulatedAnnealingNQueens(const NQueensBoard& startSolution, const int& target, double starttemp, double precision, double alpha):SimulatedAnnealing(startSolution, target, starttemp, precision, alpha), errors(-1){};
-
-private:
-	int errors;
-
-};
-
-
-NQueensBoard* SimulatedAnnealingNQueens::giveRandomNeighbour(const NQueensBoard &lastSolution) const{
-	return lastSolution.returnRandomNeighbour();
-}
-
-double SimulatedAnnealingNQueens::calcDistanceToTarget(const NQueensBoard &solution) const{
-	return solution.getErrors()-(*TARGET);
-}
-
-void SimulatedAnnealingNQueens::printStatus(const NQueensBoard& solution, double temp){
-	if(errors < 0 || errors > solution.getErrors()){
-		errors = solution.getErrors();
-		std::cout << "Temp: " << temp << std::endl;
-		std::cout << "Errors: " << solution.getErrors() << std::endl << std::endl;
-		//_CrtDumpMemoryLeaks();
-	}
-	//std::cout << "Temp: " << temp << std::endl;
-	//std::cout << "Errors: " << solution.getErrors() << std::endl;
-	//solution.print();
-}
-
 int main(int argc, char *argv[]){
-	srand((unsigned)time(0));
-
 	NQueensBoard startSolution(100);
-	SimulatedAnnealingNQueens sanq(startSolution, 0, 5*10E5, 1, 0.6);
+	SimulatedAnnealingNQueens<> sanq(startSolution, 0, 5*10E5, 1, 0.6, (uint64_t)time(0));
+
+	//with a file name as argument the run is checkpointed to that file every 10 seconds and 
+	//continued from it when it already exists
+	if(argc > 1){
+		if(sanq.loadCheckpoint(std::string(argv[1]))){
+			std::cout << "Continuing from iteration " << sanq.getIteration() << std::endl;
+		}
+		sanq.setCheckpointFile(argv[1], 0, 10000);
+	}
 	sanq.solve();
 
 	//std::clock_t start;
@@ -0,0 +1,95 @@
+#ifndef __SIMULATED_ANNEALING_NQUEENS_H
+#define __SIMULATED_ANNEALING_NQUEENS_H
+
+#include "../simulated_annealing.h"
+#include "../static_simulated_annealing.h"
+#include "n_queens_board.h"
+#include "fixed_n_queens_board.h"
+
+//the N-Queens problem, shared by SimulatedAnnealingNQueens and StaticSimulatedAnnealingNQueens:
+//Base is the engine, whose hooks are overridden (SimulatedAnnealing) or hidden (StaticSimulatedAnnealing)
+//the board can be NQueensBoard or FixedNQueensBoard<N> (when the size is known when compiling)
+template <class Base, class Board>
+class NQueensProblem:public Base{
+public:
+
+	typedef typename Base::NeighbourMode NeighbourMode;
+
+	Board* giveRandomNeighbour (const Board& lastSolution) const;
+
+	double calcDistanceToTarget (const Board& solution) const;
+
+	void printStatus (const Board& solution, double temp);
+
+	NeighbourMode getNeighbourMode() const;
+
+	void applyRandomMove(Board& solution);
+
+	void undoMove(Board& solution);
+
+	NQueensProblem(const Board& startSolution, const int& target, double starttemp, double precision, double alpha, uint64_t seed):Base(startSolution, target, starttemp, precision, alpha, seed), errors(-1){};
+
+private:
+	int errors;
+
+};
+
+template <class Base, class Board>
+Board* NQueensProblem<Base,Board>::giveRandomNeighbour(const Board &lastSolution) const{
+	Board* neighbour = this->copySolution(lastSolution);
+	neighbour->applyRandomSwap(this->rng);
+	return neighbour;
+}
+
+template <class Base, class Board>
+double NQueensProblem<Base,Board>::calcDistanceToTarget(const Board &solution) const{
+	return solution.getErrors()-(*this->TARGET);
+}
+
+template <class Base, class Board>
+typename NQueensProblem<Base,Board>::NeighbourMode NQueensProblem<Base,Board>::getNeighbourMode() const{
+	return Base::IN_PLACE_NEIGHBOUR;
+}
+
+template <class Base, class Board>
+void NQueensProblem<Base,Board>::applyRandomMove(Board &solution){
+	solution.applyRandomSwap(this->rng);
+}
+
+template <class Base, class Board>
+void NQueensProblem<Base,Board>::undoMove(Board &solution){
+	solution.undoSwap();
+}
+
+template <class Base, class Board>
+void NQueensProblem<Base,Board>::printStatus(const Board& solution, double temp){
+	if(errors < 0 || errors > solution.getErrors()){
+		errors = solution.getErrors();
+		std::ostringstream line;
+		line << "Temp: " << temp << " Errors: " << solution.getErrors();
+		this->writeLog(line.str());
+		//_CrtDumpMemoryLeaks();
+	}
+	//std::cout << "Temp: " << temp << std::endl;
+	//std::cout << "Errors: " << solution.getErrors() << std::endl;
+	//solution.print();
+}
+
+template <class Board = NQueensBoard>
+class SimulatedAnnealingNQueens:public NQueensProblem<SimulatedAnnealing<Board, int>, Board>{
+public:
+	SimulatedAnnealingNQueens(const Board& startSolution, const int& target, double starttemp, double precision, double alpha, uint64_t seed = 0):NQueensProblem<SimulatedAnnealing<Board, int>, Board>(startSolution, target, starttemp, precision, alpha, seed){};
+};
+
+//same problem using StaticSimulatedAnnealing, the hooks are resolved at compile time
+//the cooling schedule and acceptance rule can be chosen with the template parameters, as can the board
+template <class Cooling = GeometricCooling, class Acceptance = MetropolisAcceptance, class Board = NQueensBoard>
+class StaticSimulatedAnnealingNQueens:public NQueensProblem<StaticSimulatedAnnealing<StaticSimulatedAnnealingNQueens<Cooling,Acceptance,Board>, Board, int, Xoshiro256, Cooling, Acceptance>, Board>{
+
+	typedef NQueensProblem<StaticSimulatedAnnealing<StaticSimulatedAnnealingNQueens<Cooling,Acceptance,Board>, Board, int, Xoshiro256, Cooling, Acceptance>, Board> Problem;
+
+public:
+	StaticSimulatedAnnealingNQueens(const Board& startSolution, const int& target, double starttemp, double precision, double alpha, uint64_t seed = 0):Problem(startSolution, target, starttemp, precision, alpha, seed){};
+};
+
+#endif
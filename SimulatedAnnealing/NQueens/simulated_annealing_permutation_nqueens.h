@@ -0,0 +1,210 @@
+#ifndef __SIMULATED_ANNEALING_PERMUTATION_NQUEENS_H
+#define __SIMULATED_ANNEALING_PERMUTATION_NQUEENS_H
+
+#include <sstream>
+#include "../static_simulated_annealing.h"
+#include "permutation_board.h"
+#include "swap_move_table.h"
+
+//N-Queens on a PermutationBoard using the move interface: a move swaps the columns of two
+//queens and only its O(1) change in errors is evaluated, the board is only touched when the
+//move is accepted
+//optionally the first queen of a move is drawn from the queens in conflict (setConflictMoves()), 
+//and below a temperature the search turns into a min-conflicts descent (setPolishTemp()) or 
+//takes rejection-free steps (setRejectionFreeTemp())
+template <class Cooling = GeometricCooling, class Acceptance = MetropolisAcceptance>
+class StaticSimulatedAnnealingPermutationNQueens:public StaticSimulatedAnnealing<StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>, PermutationBoard, int, Xoshiro256, Cooling, Acceptance>{
+
+	typedef StaticSimulatedAnnealing<StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>, PermutationBoard, int, Xoshiro256, Cooling, Acceptance> Base;
+
+public:
+
+	typedef typename Base::NeighbourMode NeighbourMode;
+
+	PermutationBoard* giveRandomNeighbour (const PermutationBoard& lastSolution) const;
+
+	double calcDistanceToTarget (const PermutationBoard& solution) const;
+
+	//only prints the errors, the board can be far too large to print
+	void printStatus (const PermutationBoard& solution, double temp);
+
+	NeighbourMode getNeighbourMode() const;
+
+	void proposeMove(const PermutationBoard& solution);
+
+	double calcMoveChange(const PermutationBoard& solution, double distance);
+
+	void commitMove(PermutationBoard& solution);
+
+	void discardMove();
+
+	/**
+		Draws the first queen of every move from the queens in conflict instead of from all 
+		queens (off by default), near the end of a run almost all queens are free of conflicts 
+		and moving them is almost always rejected
+	*/
+	void setConflictMoves(bool conflictMoves);
+
+	/**
+		Below the temperature every move takes a queen in conflict and swaps it with the best of 
+		a number of random queens, and only when that doesn't add errors (min-conflicts)
+			@param temp The temperature the descent starts at, 0 (the default) turns it off
+			@param candidates The number of queens tried for the swap
+	*/
+	void setPolishTemp(double temp, int candidates = 64);
+
+	/**
+		Below the temperature every step is rejection-free (see useRejectionFreeSteps()), the swaps 
+		are drawn from a SwapMoveTable, which takes O(N*N) memory and O(N) work per step, so this 
+		only pays off when far fewer than 1 in 10N proposals would be accepted. Swaps that don't 
+		change the errors keep about 1% accepted at any temperature, so only small boards (up to 
+		about 16 queens) gain at low temperatures, see Benchmarks/benchmark_rejection_free.cpp. 
+		Takes precedence over setPolishTemp().
+			@param temp The temperature the rejection-free steps start at, 0 (the default) turns them off
+	*/
+	void setRejectionFreeTemp(double temp);
+
+	bool useRejectionFreeSteps() const;
+
+	double proposeRejectionFreeMove(const PermutationBoard& solution, double temp);
+
+	StaticSimulatedAnnealingPermutationNQueens(const PermutationBoard& startSolution, const int& target, double starttemp, double precision, double alpha, uint64_t seed = 0):Base(startSolution, target, starttemp, precision, alpha, seed), proposedRow1(0), proposedRow2(0), conflictMoves(false), polishTemp(0), polishCandidates(64), rejectionFreeTemp(0), moveTableBoard(0), moveTableVersion(0){};
+
+private:
+	int proposedRow1, proposedRow2; // rows chosen by the last proposeMove
+	bool conflictMoves;
+	double polishTemp;
+	int polishCandidates;
+	double rejectionFreeTemp;
+	SwapMoveTable moveTable; // follows the board while rejection-free steps are taken
+	const PermutationBoard* moveTableBoard; // the board the table is in line with, at moveTableVersion
+	long moveTableVersion;
+
+	void proposeMinConflictsMove(const PermutationBoard& solution);
+
+};
+
+template <class Cooling, class Acceptance>
+PermutationBoard* StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::giveRandomNeighbour(const PermutationBoard &lastSolution) const{
+	PermutationBoard* neighbour = this->copySolution(lastSolution);
+	neighbour->applyRandomSwap(this->rng);
+	return neighbour;
+}
+
+template <class Cooling, class Acceptance>
+double StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::calcDistanceToTarget(const PermutationBoard &solution) const{
+	return solution.getErrors()-(*this->TARGET);
+}
+
+template <class Cooling, class Acceptance>
+void StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::printStatus(const PermutationBoard& solution, double temp){
+	std::ostringstream line;
+	line << "Temp: " << temp << " Errors: " << solution.getErrors();
+	this->writeLog(line.str());
+}
+
+template <class Cooling, class Acceptance>
+typename StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::NeighbourMode StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::getNeighbourMode() const{
+	return Base::MOVE_NEIGHBOUR;
+}
+
+template <class Cooling, class Acceptance>
+inline void StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::proposeMove(const PermutationBoard &solution){
+	if(this->getTemp() < polishTemp){
+		proposeMinConflictsMove(solution);
+		return;
+	}
+	proposedRow1 = conflictMoves ? solution.randomConflictRow(this->rng) : this->rng.nextInt(solution.getSize());
+	proposedRow2 = this->rng.nextInt(solution.getSize());
+}
+
+template <class Cooling, class Acceptance>
+void StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::proposeMinConflictsMove(const PermutationBoard &solution){
+	//swapping the queen with itself changes nothing, so a move never adds errors, moves that 
+	//keep the errors are taken to walk over plateaus
+	proposedRow1 = solution.randomConflictRow(this->rng);
+	proposedRow2 = proposedRow1;
+	int bestChange = 0;
+	for(int i=0; i<polishCandidates; i++){
+		int row = this->rng.nextInt(solution.getSize());
+		int change = solution.swapDelta(proposedRow1, row);
+		if(change <= bestChange){
+			bestChange = change;
+			proposedRow2 = row;
+		}
+	}
+}
+
+template <class Cooling, class Acceptance>
+inline double StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::calcMoveChange(const PermutationBoard &solution, double distance){
+	return solution.swapDelta(proposedRow1, proposedRow2);
+}
+
+template <class Cooling, class Acceptance>
+inline void StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::commitMove(PermutationBoard &solution){
+	//the move table only follows the moves of rejection-free steps, it's built again when the 
+	//board was changed otherwise (other steps, swapSolution(), a checkpoint)
+	bool tableInLine = &solution == moveTableBoard && solution.getVersion() == moveTableVersion;
+	solution.applySwap(proposedRow1, proposedRow2);
+	if(tableInLine && useRejectionFreeSteps()){
+		moveTable.update(solution, proposedRow1, proposedRow2);
+		moveTableVersion = solution.getVersion();
+	}
+}
+
+template <class Cooling, class Acceptance>
+inline void StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::discardMove(){
+}
+
+template <class Cooling, class Acceptance>
+void StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::setConflictMoves(bool conflictMoves){
+	this->conflictMoves = conflictMoves;
+}
+
+template <class Cooling, class Acceptance>
+void StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::setPolishTemp(double temp, int candidates){
+	assert(candidates > 0);
+	polishTemp = temp;
+	polishCandidates = candidates;
+}
+
+template <class Cooling, class Acceptance>
+void StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::setRejectionFreeTemp(double temp){
+	rejectionFreeTemp = temp;
+}
+
+template <class Cooling, class Acceptance>
+bool StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::useRejectionFreeSteps() const{
+	return this->getTemp() < rejectionFreeTemp;
+}
+
+template <class Cooling, class Acceptance>
+double StaticSimulatedAnnealingPermutationNQueens<Cooling,Acceptance>::proposeRejectionFreeMove(const PermutationBoard &solution, double temp){
+	if(&solution != moveTableBoard || solution.getVersion() != moveTableVersion){
+		moveTable.rebuild(solution);
+		moveTableBoard = &solution;
+		moveTableVersion = solution.getVersion();
+	}
+	double weights[SwapMoveTable::MAX_CHANGE-SwapMoveTable::MIN_CHANGE+1];
+	double total = 0;
+	for(int change=SwapMoveTable::MIN_CHANGE; change<=SwapMoveTable::MAX_CHANGE; change++){
+		double probability = change <= 0 ? 1 : this->calcProbability(change, temp);
+		weights[change-SwapMoveTable::MIN_CHANGE] = moveTable.getMoves(change)*(probability < 1 ? probability : 1);
+		total += weights[change-SwapMoveTable::MIN_CHANGE];
+	}
+	if(total <= 0){
+		return 0;
+	}
+	double draw = this->rng.nextDouble()*total;
+	int change = SwapMoveTable::MIN_CHANGE;
+	while(change < SwapMoveTable::MAX_CHANGE && (draw >= weights[change-SwapMoveTable::MIN_CHANGE] || moveTable.getMoves(change) == 0)){
+		draw -= weights[change-SwapMoveTable::MIN_CHANGE];
+		change++;
+	}
+	moveTable.randomMove(change, this->rng, proposedRow1, proposedRow2);
+	//a normal step draws both rows uniformly, so every swap has 2 of the N*N proposals
+	double n = solution.getSize();
+	return 2*total/(n*n);
+}
+
+#endif
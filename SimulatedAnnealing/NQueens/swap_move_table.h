@@ -0,0 +1,224 @@
+#ifndef __SWAP_MOVE_TABLE_H
+#define __SWAP_MOVE_TABLE_H
+
+#include <vector>
+#include <assert.h>
+#include <stdint.h>
+#include <cmath>
+#include "permutation_board.h"
+
+/******************************************************************//**
+
+   SwapMoveTable
+
+   All swaps of two queens of a PermutationBoard, grouped by the
+   change in errors they cause (always between -4 and 4), for
+   rejection-free steps: the chance a swap is accepted only depends
+   on its change, so a step draws the change with the weights
+   count*probability and then a swap with that change uniformly.
+
+   The table is built for a board in O(N*N) and then follows it
+   swap by swap: after a swap only the swaps whose change can be
+   different are scored again (the ones with a queen of the swapped
+   rows, with a queen on a diagonal whose count changed or that move
+   a queen onto such a diagonal, O(N) swaps). It takes about 9 bytes
+   per pair of queens, so it's meant for boards up to a few thousand
+   queens.
+
+***************************************************************************/
+
+class SwapMoveTable{
+
+public:
+	static const int MIN_CHANGE = -4;
+	static const int MAX_CHANGE = 4;
+
+	SwapMoveTable();
+
+	//builds the table for the board
+	void rebuild(const PermutationBoard& board);
+
+	//the queens of both rows of the board were swapped since the table was built or updated
+	void update(const PermutationBoard& board, int row1, int row2);
+
+	//number of swaps (of two different queens) that change the errors by change
+	long getMoves(int change) const;
+
+	//number of swaps of two different queens, N*(N-1)/2
+	long getPairs() const;
+
+	//draws a swap that changes the errors by change uniformly, there has to be one
+	template <class RNG> void randomMove(int change, RNG& rng, int& row1, int& row2) const;
+
+private:
+	static const int CLASSES = MAX_CHANGE-MIN_CHANGE+1;
+
+	int N;
+	std::vector<int> columns; // the board as of the last rebuild or update
+	std::vector<int> rows; // row of the queen of each column
+	std::vector<signed char> pairChange; // change of every pair, see pairIndex()
+	std::vector<uint32_t> pairPosition; // position of every pair in moves
+	std::vector<uint32_t> moves[CLASSES]; // the pairs with each change
+
+	void rescoreRow(const PermutationBoard& board, int row);
+	void rescoreUpTargets(const PermutationBoard& board, int diagonal);
+	void rescoreDownTargets(const PermutationBoard& board, int diagonal);
+	void rescore(const PermutationBoard& board, int row1, int row2);
+
+	//index of the pair of different rows in pairChange and pairPosition
+	static uint32_t pairIndex(int row1, int row2);
+	static void pairRows(uint32_t index, int& row1, int& row2);
+
+};
+
+template <class RNG>
+void SwapMoveTable::randomMove(int change, RNG& rng, int& row1, int& row2) const{
+	const std::vector<uint32_t>& candidates = moves[change-MIN_CHANGE];
+	assert(!candidates.empty());
+	pairRows(candidates[rng.nextInt((int)candidates.size())], row1, row2);
+}
+
+inline long SwapMoveTable::getMoves(int change) const{
+	return (long)moves[change-MIN_CHANGE].size();
+}
+
+inline long SwapMoveTable::getPairs() const{
+	return (long)N*(N-1)/2;
+}
+
+inline uint32_t SwapMoveTable::pairIndex(int row1, int row2){
+	if(row1 < row2){
+		int hulp = row1;
+		row1 = row2;
+		row2 = hulp;
+	}
+	return (uint32_t)((uint64_t)row1*(row1-1)/2 + row2);
+}
+
+inline SwapMoveTable::SwapMoveTable():N(0){
+}
+
+inline void SwapMoveTable::rebuild(const PermutationBoard& board){
+	N = board.getSize();
+	assert(N <= 65536); // the pairs are numbered with 32 bits
+	columns.resize(N);
+	rows.resize(N);
+	for(int row=0; row<N; row++){
+		columns[row] = board.getColumn(row);
+		rows[columns[row]] = row;
+	}
+	size_t pairs = (size_t)N*(N-1)/2;
+	pairChange.resize(pairs);
+	pairPosition.resize(pairs);
+	for(int i=0; i<CLASSES; i++){
+		moves[i].clear();
+	}
+	for(int row1=1; row1<N; row1++){
+		for(int row2=0; row2<row1; row2++){
+			uint32_t index = pairIndex(row1, row2);
+			int change = board.swapDelta(row1, row2);
+			std::vector<uint32_t>& members = moves[change-MIN_CHANGE];
+			pairChange[index] = (signed char)change;
+			pairPosition[index] = (uint32_t)members.size();
+			members.push_back(index);
+		}
+	}
+}
+
+//the change of a swap only depends on the counts of the diagonals it takes its queens from and
+//puts them on, so only swaps that touch one of the up to 8 diagonals whose count changed are scored
+inline void SwapMoveTable::update(const PermutationBoard& board, int row1, int row2){
+	if(row1 == row2){
+		return;
+	}
+	int col1 = columns[row1];
+	int col2 = columns[row2];
+	int up[4] = {row1+col1, row2+col2, row1+col2, row2+col1};
+	int down[4] = {row1-col1+N-1, row2-col2+N-1, row1-col2+N-1, row2-col1+N-1};
+	columns[row1] = col2;
+	columns[row2] = col1;
+	rows[col2] = row1;
+	rows[col1] = row2;
+
+	rescoreRow(board, row1);
+	rescoreRow(board, row2);
+	for(int i=0; i<4; i++){
+		//swaps taking a queen from the diagonal
+		for(int row = up[i] < N ? 0 : up[i]-N+1; row <= up[i] && row < N; row++){
+			if(columns[row] == up[i]-row && row != row1 && row != row2){
+				rescoreRow(board, row);
+			}
+		}
+		for(int row = down[i] < N ? 0 : down[i]-N+1; row <= down[i] && row < N; row++){
+			if(columns[row] == row-down[i]+N-1 && row != row1 && row != row2){
+				rescoreRow(board, row);
+			}
+		}
+		//swaps putting a queen on the diagonal
+		rescoreUpTargets(board, up[i]);
+		rescoreDownTargets(board, down[i]);
+	}
+}
+
+inline void SwapMoveTable::rescoreRow(const PermutationBoard& board, int row){
+	for(int other=0; other<N; other++){
+		if(other != row){
+			rescore(board, row, other);
+		}
+	}
+}
+
+//swaps moving the queen of row onto square (row, column) with row+column on the diagonal
+inline void SwapMoveTable::rescoreUpTargets(const PermutationBoard& board, int diagonal){
+	for(int row = diagonal < N ? 0 : diagonal-N+1; row <= diagonal && row < N; row++){
+		int other = rows[diagonal-row];
+		if(other != row){
+			rescore(board, row, other);
+		}
+	}
+}
+
+//the same for row-column+N-1 on the diagonal
+inline void SwapMoveTable::rescoreDownTargets(const PermutationBoard& board, int diagonal){
+	for(int row = diagonal < N ? 0 : diagonal-N+1; row <= diagonal && row < N; row++){
+		int other = rows[row-diagonal+N-1];
+		if(other != row){
+			rescore(board, row, other);
+		}
+	}
+}
+
+inline void SwapMoveTable::rescore(const PermutationBoard& board, int row1, int row2){
+	uint32_t index = pairIndex(row1, row2);
+	int change = board.swapDelta(row1, row2);
+	int oldChange = pairChange[index];
+	if(change == oldChange){
+		return;
+	}
+	//takes the pair out of its old class by moving the last member of the class into its place
+	std::vector<uint32_t>& oldMembers = moves[oldChange-MIN_CHANGE];
+	uint32_t last = oldMembers.back();
+	oldMembers[pairPosition[index]] = last;
+	pairPosition[last] = pairPosition[index];
+	oldMembers.pop_back();
+
+	std::vector<uint32_t>& members = moves[change-MIN_CHANGE];
+	pairChange[index] = (signed char)change;
+	pairPosition[index] = (uint32_t)members.size();
+	members.push_back(index);
+}
+
+inline void SwapMoveTable::pairRows(uint32_t index, int& row1, int& row2){
+	//row1 is the largest row with row1*(row1-1)/2 <= index
+	int row = (int)((1 + sqrt(1 + 8.0*index))/2);
+	while((uint64_t)row*(row-1)/2 > index){
+		row--;
+	}
+	while((uint64_t)(row+1)*row/2 <= index){
+		row++;
+	}
+	row1 = row;
+	row2 = (int)(index - (uint64_t)row*(row-1)/2);
+}
+
+#endif
@@ -0,0 +1,344 @@
+#include "flat_quadtree.h"
+#include <math.h>
+#include <assert.h>
+#include <algorithm>
+#include <queue>
+#include <limits>
+
+//deeper nodes are leaves whatever their number of points, only equal points get there
+static const int MAX_DEPTH = 48;
+
+static int popCount4(uint8_t mask){
+	return (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+}
+
+FlatQuadtree::Box FlatQuadtree::Box::child(int i) const{
+	//the same halving as Region::addtocorrectchildregion
+	double middleX = (xmax+xmin)/2;
+	double middleY = (ymax+ymin)/2;
+	Box box;
+	box.xmin = (i & 1) ? middleX : xmin;
+	box.xmax = (i & 1) ? xmax : middleX;
+	box.ymin = (i & 2) ? middleY : ymin;
+	box.ymax = (i & 2) ? ymax : middleY;
+	return box;
+}
+
+double FlatQuadtree::Box::minDistanceSquare(double x, double y) const{
+	double dx = x < xmin ? xmin-x : (x > xmax ? x-xmax : 0);
+	double dy = y < ymin ? ymin-y : (y > ymax ? y-ymax : 0);
+	return dx*dx + dy*dy;
+}
+
+bool FlatQuadtree::Box::contains(double x, double y) const{
+	return x >= xmin && x <= xmax && y >= ymin && y <= ymax;
+}
+
+FlatQuadtree::FlatQuadtree(const Region& region){
+	root.xmin = region.xmin;
+	root.xmax = region.xmax;
+	root.ymin = region.ymin;
+	root.ymax = region.ymax;
+	std::vector<Point*> regionPoints;
+	region.collectPoints(regionPoints);
+	std::vector<std::pair<double, double> > points(regionPoints.size());
+	for(size_t i=0; i<regionPoints.size(); i++){
+		points[i] = std::make_pair(regionPoints[i]->getx(), regionPoints[i]->gety());
+	}
+	build(points);
+}
+
+FlatQuadtree::FlatQuadtree(double xmin, double xmax, double ymin, double ymax, const std::vector<double>& x, const std::vector<double>& y){
+	assert(x.size() == y.size());
+	root.xmin = xmin;
+	root.xmax = xmax;
+	root.ymin = ymin;
+	root.ymax = ymax;
+	std::vector<std::pair<double, double> > points(x.size());
+	for(size_t i=0; i<x.size(); i++){
+		assert(root.contains(x[i], y[i]));
+		points[i] = std::make_pair(x[i], y[i]);
+	}
+	build(points);
+}
+
+void FlatQuadtree::build(std::vector<std::pair<double, double> >& points){
+	assert(points.size() < 0xFFFFFFFFu);
+	nodes.clear();
+	nodes.push_back(Node());
+	buildNode(0, points, 0, (uint32_t)points.size(), root, 0);
+	nodes.shrink_to_fit();
+	xs.resize(points.size());
+	ys.resize(points.size());
+	for(size_t i=0; i<points.size(); i++){
+		xs[i] = points[i].first;
+		ys[i] = points[i].second;
+	}
+}
+
+//sorts the points of the node in Z-order, their range is split over the children
+void FlatQuadtree::buildNode(uint32_t index, std::vector<std::pair<double, double> >& points, uint32_t first, uint32_t count, const Box& box, int depth){
+	double centerX = 0, centerY = 0, spread = 0;
+	for(uint32_t i=first; i<first+count; i++){
+		centerX += points[i].first;
+		centerY += points[i].second;
+	}
+	if(count > 0){
+		centerX /= count;
+		centerY /= count;
+	}
+	for(uint32_t i=first; i<first+count; i++){
+		double dx = points[i].first-centerX;
+		double dy = points[i].second-centerY;
+		spread += dx*dx + dy*dy;
+	}
+	Node& node = nodes[index];
+	node.firstChild = 0;
+	node.firstPoint = first;
+	node.nPoints = count;
+	node.childMask = 0;
+	node.centerX = centerX;
+	node.centerY = centerY;
+	node.spread = spread;
+	if(count <= (uint32_t)LEAF_SIZE || depth == MAX_DEPTH){
+		return;
+	}
+
+	//the same comparisons as Region::selectregion
+	double middleX = (box.xmax+box.xmin)/2;
+	double middleY = (box.ymax+box.ymin)/2;
+	std::vector<std::pair<double, double> >::iterator begin = points.begin()+first, end = begin+count;
+	std::vector<std::pair<double, double> >::iterator highY = std::partition(begin, end, [middleY](const std::pair<double, double>& p){ return p.second < middleY; });
+	std::vector<std::pair<double, double> >::iterator split[5];
+	split[0] = begin;
+	split[1] = std::partition(begin, highY, [middleX](const std::pair<double, double>& p){ return p.first < middleX; });
+	split[2] = highY;
+	split[3] = std::partition(highY, end, [middleX](const std::pair<double, double>& p){ return p.first < middleX; });
+	split[4] = end;
+
+	uint8_t mask = 0;
+	for(int i=0; i<4; i++){
+		if(split[i+1] != split[i]){
+			mask |= (uint8_t)(1 << i);
+		}
+	}
+	//the node reference isn't used anymore once the children are added
+	uint32_t firstChild = (uint32_t)nodes.size();
+	nodes[index].firstChild = firstChild;
+	nodes[index].childMask = mask;
+	nodes.resize(nodes.size() + popCount4(mask));
+	uint32_t child = firstChild;
+	for(int i=0; i<4; i++){
+		if(mask & (1 << i)){
+			buildNode(child++, points, (uint32_t)(split[i]-points.begin()), (uint32_t)(split[i+1]-split[i]), box.child(i), depth+1);
+		}
+	}
+}
+
+int FlatQuadtree::findClosestPoint(double x, double y) const{
+	int closest = -1;
+	double closestDistanceSquare = std::numeric_limits<double>::infinity();
+	if(!isEmpty()){
+		findClosestPoint(0, root, x, y, closest, closestDistanceSquare);
+	}
+	return closest;
+}
+
+void FlatQuadtree::findClosestPoint(uint32_t index, const Box& box, double x, double y, int& closest, double& closestDistanceSquare) const{
+	const Node& node = nodes[index];
+	if(isLeaf(node)){
+		for(uint32_t i=node.firstPoint; i<node.firstPoint+node.nPoints; i++){
+			double dx = xs[i]-x;
+			double dy = ys[i]-y;
+			double distanceSquare = dx*dx + dy*dy;
+			if(distanceSquare < closestDistanceSquare){
+				closest = (int)i;
+				closestDistanceSquare = distanceSquare;
+			}
+		}
+		return;
+	}
+	//the children closest to the coordinates first, so the others can be skipped more often
+	uint32_t children[4];
+	Box boxes[4];
+	double distances[4];
+	int n = 0;
+	uint32_t child = node.firstChild;
+	for(int i=0; i<4; i++){
+		if(node.childMask & (1 << i)){
+			Box childBox = box.child(i);
+			double distance = childBox.minDistanceSquare(x, y);
+			int j = n++;
+			for(; j>0 && distances[j-1] > distance; j--){
+				children[j] = children[j-1];
+				boxes[j] = boxes[j-1];
+				distances[j] = distances[j-1];
+			}
+			children[j] = child;
+			boxes[j] = childBox;
+			distances[j] = distance;
+			child++;
+		}
+	}
+	for(int i=0; i<n; i++){
+		if(distances[i] < closestDistanceSquare){
+			findClosestPoint(children[i], boxes[i], x, y, closest, closestDistanceSquare);
+		}
+	}
+}
+
+//the points are two plain arrays, so this loop is easy to vectorize
+double FlatQuadtree::sumDistances(double x, double y, uint32_t first, uint32_t count) const{
+	const double* px = &xs[0];
+	const double* py = &ys[0];
+	double total = 0;
+	for(uint32_t i=first; i<first+count; i++){
+		double dx = px[i]-x;
+		double dy = py[i]-y;
+		total += sqrt(dx*dx + dy*dy);
+	}
+	return total;
+}
+
+double FlatQuadtree::calcTotalDistance(int point) const{
+	return sumDistances(xs[point], ys[point], 0, (uint32_t)xs.size());
+}
+
+double FlatQuadtree::calcTotalDistance(int point, double minTotal) const{
+	//no point is further from the point than the furthest corner of the domain
+	double x = xs[point], y = ys[point];
+	double dx = std::max(x-root.xmin, root.xmax-x);
+	double dy = std::max(y-root.ymin, root.ymax-y);
+	double maxReach = sqrt(dx*dx + dy*dy);
+
+	const uint32_t BLOCK = 1024;
+	uint32_t n = (uint32_t)xs.size();
+	double total = 0;
+	for(uint32_t first=0; first<n; first+=BLOCK){
+		uint32_t count = std::min(BLOCK, n-first);
+		total += sumDistances(x, y, first, count);
+		double remaining = (double)(n-first-count);
+		if(remaining > 0 && total + remaining*maxReach <= minTotal){
+			return total + remaining*maxReach;
+		}
+	}
+	return total;
+}
+
+double FlatQuadtree::approximateTotalDistance(int point, double theta, double& maxError) const{
+	double total = 0;
+	maxError = 0;
+	if(!isEmpty()){
+		addApproximateDistances(0, root, xs[point], ys[point], theta, total, maxError);
+	}
+	return total;
+}
+
+void FlatQuadtree::addApproximateDistances(uint32_t index, const Box& box, double x, double y, double theta, double& total, double& maxError) const{
+	const Node& node = nodes[index];
+	if(isLeaf(node)){
+		total += sumDistances(x, y, node.firstPoint, node.nPoints);
+		return;
+	}
+	//the bounds of the node take the place of the box around its points in Region
+	if(!box.contains(x, y)){
+		double dx = x-node.centerX;
+		double dy = y-node.centerY;
+		double d = sqrt(dx*dx + dy*dy);
+		double sizeX = box.xmax-box.xmin;
+		double sizeY = box.ymax-box.ymin;
+		double sizeSquare = sizeX*sizeX + sizeY*sizeY;
+		if(sizeSquare < theta*theta*d*d){
+			double spread = std::min(node.spread, node.nPoints*sizeSquare);
+			total += node.nPoints*d + spread/(4*d);
+			maxError += spread/(4*d);
+			return;
+		}
+	}
+	uint32_t child = node.firstChild;
+	for(int i=0; i<4; i++){
+		if(node.childMask & (1 << i)){
+			addApproximateDistances(child++, box.child(i), x, y, theta, total, maxError);
+		}
+	}
+}
+
+double FlatQuadtree::boundTotalDistance(double x, double y, double theta) const{
+	double total = 0;
+	double maxError = 0;
+	addApproximateDistances(0, root, x, y, theta, total, maxError);
+	return (total + maxError)*(1 + 1e-12);
+}
+
+int FlatQuadtree::findFurthestPoint(double& total, long& nodesVisited, double theta) const{
+	//the total distance is convex in the position, a node is bounded by the corners of its box
+	struct Entry{
+		double bound;
+		uint32_t index;
+		Box box;
+		bool operator<(const Entry& other) const{
+			return bound < other.bound;
+		}
+	};
+	std::priority_queue<Entry> queue;
+	int furthest = -1;
+	total = 0;
+	nodesVisited = 0;
+	if(!isEmpty()){
+		Entry entry = {std::numeric_limits<double>::infinity(), 0, root};
+		queue.push(entry);
+	}
+
+	while(!queue.empty() && queue.top().bound > total){
+		Entry current = queue.top();
+		queue.pop();
+		const Node& node = nodes[current.index];
+		if(isLeaf(node)){
+			for(uint32_t i=node.firstPoint; i<node.firstPoint+node.nPoints; i++){
+				if(boundTotalDistance(xs[i], ys[i], theta) <= total){
+					continue;
+				}
+				double distance = calcTotalDistance((int)i);
+				if(furthest == -1 || distance > total){
+					furthest = (int)i;
+					total = distance;
+				}
+			}
+			continue;
+		}
+		uint32_t child = node.firstChild;
+		for(int i=0; i<4; i++){
+			if(!(node.childMask & (1 << i))){
+				continue;
+			}
+			nodesVisited++;
+			Entry entry;
+			entry.index = child++;
+			entry.box = current.box.child(i);
+			//the points of a leaf give a tighter box than its bounds
+			const Node& childNode = nodes[entry.index];
+			double xmin = entry.box.xmin, xmax = entry.box.xmax, ymin = entry.box.ymin, ymax = entry.box.ymax;
+			if(isLeaf(childNode)){
+				xmin = ymin = std::numeric_limits<double>::infinity();
+				xmax = ymax = -std::numeric_limits<double>::infinity();
+				for(uint32_t p=childNode.firstPoint; p<childNode.firstPoint+childNode.nPoints; p++){
+					xmin = std::min(xmin, xs[p]);
+					xmax = std::max(xmax, xs[p]);
+					ymin = std::min(ymin, ys[p]);
+					ymax = std::max(ymax, ys[p]);
+				}
+			}
+			entry.bound = std::max(
+				std::max(boundTotalDistance(xmin, ymin, theta), boundTotalDistance(xmax, ymin, theta)),
+				std::max(boundTotalDistance(xmin, ymax, theta), boundTotalDistance(xmax, ymax, theta)));
+			if(entry.bound > total){
+				queue.push(entry);
+			}
+		}
+	}
+	return furthest;
+}
+
+size_t FlatQuadtree::getMemoryUsage() const{
+	return nodes.capacity()*sizeof(Node) + (xs.capacity() + ys.capacity())*sizeof(double);
+}
@@ -0,0 +1,128 @@
+#ifndef __FLAT_QUADTREE_H
+#define __FLAT_QUADTREE_H
+
+#include <vector>
+#include <stdint.h>
+#include "pr_quadtree.h"
+
+/******************************************************************//**
+
+   FlatQuadtree
+
+   Read-only copy of a Region for fast queries. The nodes are stored
+   in one array: the children of a node that hold points follow each
+   other, in Z-order (low x low y, high x, high y, both), and are
+   found with a 32 bit index and a mask instead of pointers. The
+   bounds of a node aren't stored but derived from the root on the
+   way down, halving them the same way Region does. The points are
+   sorted in Z-order too and kept as separate x and y arrays, so
+   every node holds a contiguous range of them, a leaf up to
+   LEAF_SIZE. A node takes 40 bytes, a point 16.
+
+   The queries are those of Region, with points named by their index
+   (0 to getPointCount()-1) instead of Point*. Changing the points
+   means building the tree again.
+
+***************************************************************************/
+
+class FlatQuadtree{
+
+public:
+	static const int LEAF_SIZE = 8;
+
+	//copies the bounds and points of the region
+	explicit FlatQuadtree(const Region& region);
+	//the square [xmin, xmax] x [ymin, ymax] with the points (x[i], y[i]) in it
+	FlatQuadtree(double xmin, double xmax, double ymin, double ymax, const std::vector<double>& x, const std::vector<double>& y);
+
+	//index of a point closest to the given coordinates, -1 when there are no points
+	int findClosestPoint(double x, double y) const;
+	//calculates the total distance of the point to all other points
+	double calcTotalDistance(int point) const;
+	//same, but stops as soon as the total can't get above minTotal (see Region::calcTotalDistance())
+	double calcTotalDistance(int point, double minTotal) const;
+	//see Region::approximateTotalDistance()
+	double approximateTotalDistance(int point, double theta, double& maxError) const;
+	//see Region::findFurthestPoint(), returns the index of the point or -1
+	int findFurthestPoint(double& total, long& nodesVisited, double theta = 0.3) const;
+
+	//generates random coordinates within the domain, like Region
+	template <class RNG> double getRandX(RNG& rng) const;
+	template <class RNG> double getRandY(RNG& rng) const;
+
+	double getX(int point) const;
+	double getY(int point) const;
+	bool isEmpty() const;
+	int getPointCount() const;
+	int getNodeCount() const;
+	//bytes taken by the nodes and the points
+	size_t getMemoryUsage() const;
+
+private:
+	struct Node{
+		uint32_t firstChild; // index of the first child with points, 0 for a leaf
+		uint32_t firstPoint; // the points are [firstPoint, firstPoint+nPoints)
+		uint32_t nPoints;
+		uint8_t childMask; // bit i is set when child i holds points
+		double centerX, centerY; // centroid of the points
+		double spread; // sum of the squared distances of the points to the centroid
+	};
+
+	//bounds of a node, derived from those of its parent
+	struct Box{
+		double xmin, xmax, ymin, ymax;
+		Box child(int i) const;
+		double minDistanceSquare(double x, double y) const;
+		bool contains(double x, double y) const;
+	};
+
+	Box root;
+	std::vector<Node> nodes; // nodes[0] is the root
+	std::vector<double> xs, ys; // the points in Z-order
+
+	void build(std::vector<std::pair<double, double> >& points);
+	void buildNode(uint32_t index, std::vector<std::pair<double, double> >& points, uint32_t first, uint32_t count, const Box& box, int depth);
+	bool isLeaf(const Node& node) const;
+
+	void findClosestPoint(uint32_t index, const Box& box, double x, double y, int& closest, double& closestDistanceSquare) const;
+	double sumDistances(double x, double y, uint32_t first, uint32_t count) const;
+	void addApproximateDistances(uint32_t index, const Box& box, double x, double y, double theta, double& total, double& maxError) const;
+	double boundTotalDistance(double x, double y, double theta) const;
+
+};
+
+template <class RNG>
+double FlatQuadtree::getRandX(RNG& rng) const{
+	return rng.nextInt(int(root.xmax-root.xmin+1))+root.xmin;
+}
+
+template <class RNG>
+double FlatQuadtree::getRandY(RNG& rng) const{
+	return rng.nextInt(int(root.ymax-root.ymin+1))+root.ymin;
+}
+
+inline double FlatQuadtree::getX(int point) const{
+	return xs[point];
+}
+
+inline double FlatQuadtree::getY(int point) const{
+	return ys[point];
+}
+
+inline bool FlatQuadtree::isEmpty() const{
+	return xs.empty();
+}
+
+inline int FlatQuadtree::getPointCount() const{
+	return (int)xs.size();
+}
+
+inline int FlatQuadtree::getNodeCount() const{
+	return (int)nodes.size();
+}
+
+inline bool FlatQuadtree::isLeaf(const Node& node) const{
+	return node.childMask == 0;
+}
+
+#endif
@@ -2,8 +2,8 @@
 #include "math.h"
 #include <assert.h>
 #include <queue>
-#include <cstdlib>	// needed for random
-#include <ctime>
+#include <algorithm>
+#include <limits>
 
 //using namespace std;
 
@@ -61,14 +61,16 @@ Region::Region(double xmin, double xmax, double ymin, double ymax, int level){
 	children = 0;
 	point = 0;
 	this->level = level;
+	updateAggregates();
 }
 
 Region::Region(const Region &region){
-	this->point = new Point(*region.point);
+	this->point = region.point != 0 ? new Point(*region.point) : 0;
+	this->children = 0;
 	if(region.children != 0){
 		this->children = new Region*[4];
 		for(int i=0; i<4; i++){
-			children[i] = new Region(*region.children[i]);
+			children[i] = region.children[i] != 0 ? new Region(*region.children[i]) : 0;
 		}
 	}
 	this->level = region.level;
@@ -76,10 +78,12 @@ Region::Region(const Region &region){
 	this->xmax = region.xmax;
 	this->ymin = region.ymin;
 	this->ymax = region.ymax;
+	updateAggregates();
 }
 
 bool Region::addPoint(double x, double y){
 	if(x >= xmin &&  x <= xmax && y >= ymin && y <= ymax){
+		bool added = true;
 
 		if(isLeaf() && point == 0){
 			//empty leaf, should only happen once
@@ -87,7 +91,7 @@ bool Region::addPoint(double x, double y){
 
 		}else if(point==0){
 			// we need to  move down the tree
-			addtocorrectchildregion(x, y);
+			added = addtocorrectchildregion(x, y);
 
 		}else if((x!=point->getx() || y!=point->gety())){ // existing point has to be moved into new layer together with new point
 			children = new Region*[4]; //make new table of children
@@ -108,7 +112,11 @@ bool Region::addPoint(double x, double y){
 			std::cout << "Couldn't add " << x << "," << y << std::endl;
 			return false;
 		}
-		return true;
+		//the regions on the way to the point are updated on the way back up
+		if(added){
+			updateAggregates();
+		}
+		return added;
 	}else{
 		std::cout << "Invalid domain for " << x << "," << y << std::endl;
 		return false;
@@ -144,21 +152,24 @@ bool Region::removePoint(double x, double y){
 		if(currentRegion == this){
 			delete currentRegion->point;
 			currentRegion->point = 0;
+			updateAggregates();
 		}else{
 			delete currentRegion; // should remove region and point!
-			Region* regionAbove = trajectory.top(); //no pop yet, we'll still have to check if it has to be merged so it stays in the stack for now
+			Region* regionAbove = trajectory.top(); //no pop yet, it's updated and merged with the others
 
 			for(int i=0; i<4; i++){ //set correct childpointer to null
 				if(regionAbove->children[i]==currentRegion){
 					regionAbove->children[i]=0;
 				}
 			}
+			//from the bottom up, so the aggregates of the children are already right
 			while(!trajectory.empty()){
+				regionAbove = trajectory.top();
+				trajectory.pop();
+				regionAbove->updateAggregates();
 				if(regionAbove->shouldMerge()){
 					regionAbove->merge();
 				}
-				regionAbove = trajectory.top();
-				trajectory.pop();
 			}
 
 		}
@@ -167,7 +178,7 @@ bool Region::removePoint(double x, double y){
 }
 
 bool Region::shouldMerge() const{
-	return (!isLeaf() && countPoints()==1);
+	return (!isLeaf() && nPoints==1);
 }
 
 Region* Region::getParentOfOnlyPoint(){ //CAUTION: won't check if there is more than one point anymore!
@@ -197,26 +208,12 @@ void Region::merge(){
 	children = 0;
 }
 
-int Region::countPoints() const{
-	if(isLeaf()){
-		return point == 0 ? 0 : 1;
-	}else{
-		int count = 0;
-		for(int i=0; i<4; i++){
-			if(children[i]!=0){
-				count+=children[i]->countPoints();
-			}
-		}
-		return count;
-	}	
-}
-
 bool Region::isLeaf() const{
 	return children == 0;
 }
 
 void Region::buildTrajectory(double x, double y, std::stack<Region*> &trajectory){ // will either return a trajectory to the point or an empty trajectory
-	if(!this->isLeaf()){ //then there is no point present in this region
+	if(!this->isLeaf() && children[selectregion(x,y)] != 0){ //then there is no point present in this region
 		// descends for the search
 		trajectory.push(this);
 		children[selectregion(x,y)]->buildTrajectory(x, y, trajectory);
@@ -275,7 +272,7 @@ int Region::selectregion(double x, double y) const{
 	}
 }
 
-void Region::addtocorrectchildregion(double x, double y){
+bool Region::addtocorrectchildregion(double x, double y){
 	int region = selectregion(x,y);
 
 	double middle_x = getMidX();
@@ -299,7 +296,62 @@ void Region::addtocorrectchildregion(double x, double y){
 
 
 	}
-	children[region]->addPoint(x,y);
+	return children[region]->addPoint(x,y);
+}
+
+void Region::updateAggregates(){
+	if(isLeaf()){
+		nPoints = point != 0 ? 1 : 0;
+		centroidX = point != 0 ? point->getx()-getMidX() : 0;
+		centroidY = point != 0 ? point->gety()-getMidY() : 0;
+		spread = 0;
+		pointXmin = pointXmax = point != 0 ? point->getx() : 0;
+		pointYmin = pointYmax = point != 0 ? point->gety() : 0;
+	}else{
+		nPoints = 0;
+		centroidX = centroidY = spread = 0;
+		pointXmin = pointXmax = pointYmin = pointYmax = 0;
+		//the centroids of the children relative to the middle of this region
+		double childX[4], childY[4];
+		for(int i=0; i<4; i++){
+			Region* child = children[i];
+			if(child == 0 || child->nPoints == 0){
+				continue;
+			}
+			if(nPoints == 0){
+				pointXmin = child->pointXmin;
+				pointXmax = child->pointXmax;
+				pointYmin = child->pointYmin;
+				pointYmax = child->pointYmax;
+			}else{
+				pointXmin = std::min(pointXmin, child->pointXmin);
+				pointXmax = std::max(pointXmax, child->pointXmax);
+				pointYmin = std::min(pointYmin, child->pointYmin);
+				pointYmax = std::max(pointYmax, child->pointYmax);
+			}
+			childX[i] = child->centroidX + (child->getMidX()-getMidX());
+			childY[i] = child->centroidY + (child->getMidY()-getMidY());
+			nPoints += child->nPoints;
+			centroidX += child->nPoints*childX[i];
+			centroidY += child->nPoints*childY[i];
+		}
+		if(nPoints == 0){
+			return;
+		}
+		centroidX /= nPoints;
+		centroidY /= nPoints;
+		//spread around the centroid from the spread of every child around its own centroid, 
+		//all terms are positive so nothing cancels (unlike sums of x*x+y*y)
+		for(int i=0; i<4; i++){
+			Region* child = children[i];
+			if(child == 0 || child->nPoints == 0){
+				continue;
+			}
+			double dx = childX[i]-centroidX;
+			double dy = childY[i]-centroidY;
+			spread += child->spread + child->nPoints*(dx*dx + dy*dy);
+		}
+	}
 }
 
 double Region::getMidX() const{
@@ -332,48 +384,43 @@ double calcDistanceSquare(Point* p1, Point* p2){
 }
 
 Region* Region::findParentOfClosestPoint(double x, double y){
-	std::queue<Region*> queue;
-	Region* currentClosest = 0;
-	queue.push(this);
+	Region* closest = 0;
+	double closestDistance = std::numeric_limits<double>::infinity();
+	searchClosestPoint(x, y, closest, closestDistance);
+	return closest;
+}
 
-	while(!queue.empty()){
-		Region* currentRegion = queue.front();
-		queue.pop();
-		//cout << "Pop" << endl;
-		if(currentRegion->isLeaf()){ //then the closest point of this region would be the point in the region itsself
-			if(currentClosest == 0 || currentClosest->point == 0){
-				currentClosest = currentRegion;
-				//cout << "Current closest set because no point has been found yet" << endl;
-				
-				//cout << "Press any key to continue..." << endl;
-				//cin.get();
-			}
-			else if(currentRegion->point != 0 && 
-				(currentClosest->point != 0 && calcDistanceSquare(x,y,currentRegion->point)<calcDistanceSquare(x,y,currentClosest->point))
-				){
-				currentClosest = currentRegion;
-				//cout << "Closer point found" << endl;
-				
-				//cout << "Press any key to continue..." << endl;
-				//cin.get();
+void Region::searchClosestPoint(double x, double y, Region*& closest, double& closestDistance){
+	if(isLeaf()){
+		if(point != 0){
+			double distance = calcDistanceSquare(x,y,point);
+			if(distance < closestDistance){
+				closest = this;
+				closestDistance = distance;
 			}
-		}else{
-			for(int i=0; i<4; i++){
-				if(currentRegion->children[i] != 0){
-					if(currentClosest == 0 || currentClosest->point == 0){
-						queue.push(currentRegion->children[i]);
-					}else if(currentRegion->children[i]->calcMinimumDistanceSquare(x, y) < calcDistanceSquare(x,y,currentClosest->point)){
-						//cout << "Possible closer point in childregion so adding it to queue" << endl;
-						queue.push(currentRegion->children[i]);
-					}
-				}
+		}
+		return;
+	}
+	//the children sorted on their minimum distance, the nearest first so the closest point is found early
+	Region* nearest[4];
+	double minimumDistance[4];
+	int nChildren = 0;
+	for(int i=0; i<4; i++){
+		if(children[i] != 0){
+			double distance = children[i]->calcMinimumDistanceSquare(x, y);
+			int j = nChildren++;
+			while(j > 0 && minimumDistance[j-1] > distance){
+				nearest[j] = nearest[j-1];
+				minimumDistance[j] = minimumDistance[j-1];
+				j--;
 			}
+			nearest[j] = children[i];
+			minimumDistance[j] = distance;
 		}
 	}
-	if(currentClosest != 0 && currentClosest->point!=0)
-		return currentClosest;
-	else
-		return 0;
+	for(int i=0; i<nChildren && minimumDistance[i] < closestDistance; i++){
+		nearest[i]->searchClosestPoint(x, y, closest, closestDistance);
+	}
 }
 
 double Region::calcMinimumDistanceSquare(double x, double y){
@@ -431,6 +478,128 @@ double Region::calcTotalDistance(Point* p){
 	return distance;
 }
 
+double Region::calcTotalDistance(Point* p, double minTotal, int nPoints){
+	//no point in the region is further from p than the furthest corner
+	double dx = std::max(p->getx()-xmin, xmax-p->getx());
+	double dy = std::max(p->gety()-ymin, ymax-p->gety());
+	double maxReach = sqrt(dx*dx + dy*dy);
+
+	double distance = 0;
+	int remaining = nPoints;
+	if(!addDistancesBounded(p, minTotal, maxReach, remaining, distance)){
+		return distance + remaining*maxReach;
+	}
+	return distance;
+}
+
+bool Region::addDistancesBounded(Point* p, double minTotal, double maxReach, int& remaining, double& total){
+	if(this->isLeaf()){
+		if(this->point != 0){
+			double distanceSquare = calcDistanceSquare(this->point, p);
+			if(distanceSquare>0){
+				total += sqrt(distanceSquare);
+			}
+			remaining--;
+			if(total + remaining*maxReach <= minTotal){
+				return false;
+			}
+		}
+	}else{
+		for(int i=0; i<4; i++){
+			if(this->children[i]!=0 && !this->children[i]->addDistancesBounded(p, minTotal, maxReach, remaining, total)){
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+double Region::approximateTotalDistance(Point* p, double theta, double& maxError) const{
+	double total = 0;
+	maxError = 0;
+	addApproximateDistances(p->getx(), p->gety(), theta, total, maxError);
+	return total;
+}
+
+void Region::addApproximateDistances(double x, double y, double theta, double& total, double& maxError) const{
+	if(nPoints == 0){
+		return;
+	}
+	if(isLeaf()){
+		total += sqrt(calcDistanceSquare(x, y, point->getx(), point->gety()));
+		return;
+	}
+	//the centroid lies in the box of the points, so it's never at p when p is outside of it
+	if(x < pointXmin || x > pointXmax || y < pointYmin || y > pointYmax){
+		double d = sqrt(calcDistanceSquare(x-getMidX(), y-getMidY(), centroidX, centroidY));
+		double sizeSquare = calcDistanceSquare(pointXmin, pointYmin, pointXmax, pointYmax);
+		if(sizeSquare < theta*theta*d*d){
+			//no point is further than size from the centroid
+			double bound = std::min(spread, nPoints*sizeSquare);
+			total += nPoints*d + bound/(4*d);
+			maxError += bound/(4*d);
+			return;
+		}
+	}
+	for(int i=0; i<4; i++){
+		if(children[i] != 0){
+			children[i]->addApproximateDistances(x, y, theta, total, maxError);
+		}
+	}
+}
+
+double Region::boundTotalDistance(double x, double y, double theta) const{
+	double total = 0;
+	double maxError = 0;
+	addApproximateDistances(x, y, theta, total, maxError);
+	//a little extra for rounding, so a bound never ends up below the exact total
+	return (total + maxError)*(1 + 1e-12);
+}
+
+Point* Region::findFurthestPoint(double& total, long& nodesVisited, double theta){
+	//regions to visit with the bound of their points, highest bound first
+	std::priority_queue<std::pair<double, Region*> > queue;
+	Point* furthest = 0;
+	total = 0;
+	nodesVisited = 0;
+	if(nPoints > 0){
+		queue.push(std::make_pair(std::numeric_limits<double>::infinity(), this));
+	}
+
+	while(!queue.empty() && queue.top().first > total){
+		Region* currentRegion = queue.top().second;
+		queue.pop();
+		if(currentRegion->isLeaf()){
+			//the bound of a leaf is that of its point, it's summed exactly when it can still win
+			double distance = calcTotalDistance(currentRegion->point);
+			if(furthest == 0 || distance > total){
+				furthest = currentRegion->point;
+				total = distance;
+			}
+			continue;
+		}
+		for(int i=0; i<4; i++){
+			Region* child = currentRegion->children[i];
+			if(child == 0 || child->nPoints == 0){
+				continue;
+			}
+			nodesVisited++;
+			double bound;
+			if(child->isLeaf()){
+				bound = boundTotalDistance(child->point->getx(), child->point->gety(), theta);
+			}else{
+				bound = std::max(
+					std::max(boundTotalDistance(child->pointXmin, child->pointYmin, theta), boundTotalDistance(child->pointXmax, child->pointYmin, theta)),
+					std::max(boundTotalDistance(child->pointXmin, child->pointYmax, theta), boundTotalDistance(child->pointXmax, child->pointYmax, theta)));
+			}
+			if(bound > total){
+				queue.push(std::make_pair(bound, child));
+			}
+		}
+	}
+	return furthest;
+}
+
 Point* Region::getPoint(){
 	if(isLeaf()){
 		return this->point;
@@ -439,16 +608,84 @@ Point* Region::getPoint(){
 	}
 }
 
-double Region::getRandX() const{
-	return rand()%int(xmax-xmin+1)+xmin;
+bool Region::isEmpty() const{
+	return isLeaf() && point == 0;
 }
 
-double Region::getRandY() const{
-	return rand()%int(ymax-ymin+1)+ymin;
+int Region::getPointCount() const{
+	return nPoints;
 }
 
-bool Region::isEmpty() const{
-	return isLeaf() && point == 0;
+size_t Region::getMemoryUsage() const{
+	size_t bytes = sizeof(Region);
+	if(point != 0){
+		bytes += sizeof(Point);
+	}
+	if(children != 0){
+		bytes += 4*sizeof(Region*);
+		for(int i=0; i<4; i++){
+			if(children[i] != 0){
+				bytes += children[i]->getMemoryUsage();
+			}
+		}
+	}
+	return bytes;
+}
+
+void Region::collectPoints(std::vector<Point*>& points) const{
+	if(isLeaf()){
+		if(point != 0){
+			points.push_back(point);
+		}
+	}else{
+		for(int i=0; i<4; i++){
+			if(children[i]!=0){
+				children[i]->collectPoints(points);
+			}
+		}
+	}
+}
+
+void Region::writeCheckpoint(CheckpointWriter& writer) const{
+	std::vector<Point*> points;
+	collectPoints(points);
+
+	writer.write(xmin);
+	writer.write(xmax);
+	writer.write(ymin);
+	writer.write(ymax);
+	writer.write(level);
+	writer.write((int)points.size());
+	for(size_t i=0; i<points.size(); i++){
+		writer.write(points[i]->getx());
+		writer.write(points[i]->gety());
+	}
+}
+
+Region* Region::readCheckpoint(CheckpointReader& reader){
+	double xmin = 0, xmax = 0, ymin = 0, ymax = 0;
+	int level = 0, nPoints = 0;
+	reader.read(xmin);
+	reader.read(xmax);
+	reader.read(ymin);
+	reader.read(ymax);
+	reader.read(level);
+	reader.read(nPoints);
+	if(!reader.good()){
+		return 0;
+	}
+
+	Region* region = new Region(xmin, xmax, ymin, ymax, level);
+	for(int i=0; i<nPoints; i++){
+		double x = 0, y = 0;
+		reader.read(x);
+		reader.read(y);
+		if(!reader.good() || !region->addPoint(x, y)){
+			delete region;
+			return 0;
+		}
+	}
+	return region;
 }
 
 /*int main(){
@@ -3,6 +3,8 @@
 
 #include <iostream>
 #include <stack>
+#include <vector>
+#include "../checkpoint.h"
 
 //using namespace std;
 
@@ -42,6 +44,7 @@ private:
 class Region{
 	//overschreven << operator
 	friend std::ostream& operator<<(std::ostream& output, Region& reg);
+	friend class FlatQuadtree;
 
 public:
 	Region(double xmin, double xmax, double ymin, double ymax, int level);
@@ -58,14 +61,51 @@ public:
 	Region* findParentOfClosestPoint(double x, double y);
 	//calculates the total distance of the point to all other points
 	double calcTotalDistance(Point* p);
+	//same, but stops as soon as the total can't get above minTotal, nPoints is the number of points in the region
+	//the result is exact when it is above minTotal, otherwise it is an upper bound that is <= minTotal
+	double calcTotalDistance(Point* p, double minTotal, int nPoints);
+	/**
+		Approximates the total distance of the point to all other points: a region whose points 
+		lie in a box of diagonal size, outside of which p lies at distance d from their 
+		centroid, with size < theta*d, counts as its points at the centroid (Barnes-Hut). 
+		The n points of such a region are between n*d and n*d + spread/(2*d) away in total, 
+		spread being the sum of the squared distances of the points to the centroid, the 
+		middle of that range is used.
+			@param theta 0 gives the exact total, the relative error is at most theta*theta/4, 
+						 0.3 to 0.5 visits O(log n) regions for points that are spread out
+			@param maxError Set to the largest possible difference with the exact total
+	*/
+	double approximateTotalDistance(Point* p, double theta, double& maxError) const;
+	/**
+		Finds the point with the largest total distance to all other points exactly, by 
+		branch and bound: the total distance is convex in the position, so no point of a 
+		region gets above the totals at the corners of the box around its points, which are 
+		bounded from above with approximateTotalDistance(). Regions are visited from the 
+		highest bound down, regions whose bound can't beat the best total found so far are 
+		skipped and only the remaining points are summed exactly.
+			@param total Set to the exact total distance of the point found
+			@param nodesVisited Set to the number of regions that were bounded
+			@param theta Accuracy of the bounds, smaller gives tighter bounds that take longer
+			@return The point, 0 when the region is empty
+	*/
+	Point* findFurthestPoint(double& total, long& nodesVisited, double theta = 0.3);
     //needed to get the point out of the closest parent
 	Point* getPoint();
 	//generates random coordinates withing the region's domain
-	double getRandX() const;
-	double getRandY() const;
+	template <class RNG> double getRandX(RNG& rng) const;
+	template <class RNG> double getRandY(RNG& rng) const;
 		
 	bool isEmpty() const;
 
+	//the total amount of points in this region, kept up to date by addPoint and removePoint
+	int getPointCount() const;
+	//bytes taken on the heap by this region, its children and points (without the allocator's own)
+	size_t getMemoryUsage() const;
+
+	//checkpoint hooks: writes the bounds and the points, reads them into a new region
+	void writeCheckpoint(CheckpointWriter& writer) const;
+	static Region* readCheckpoint(CheckpointReader& reader);
+
 
 private:
 	
@@ -77,6 +117,12 @@ private:
 	double xmin, xmax, ymin, ymax;
 	int level;
 
+	//aggregates of the points in this region, see updateAggregates()
+	int nPoints;
+	double centroidX, centroidY; // centroid of the points relative to the middle of the region, keeps its precision far from the origin
+	double spread; // sum of the squared distances of the points to the centroid
+	double pointXmin, pointXmax, pointYmin, pointYmax; // box around the points (when there are any)
+
 	//
 	//Methods
 	//
@@ -84,7 +130,10 @@ private:
 	int selectregion(double x, double y) const;
 
 	//adds a point to the correct childregion (which will be created if it doesn't exist yet)
-	void addtocorrectchildregion(double x, double y);
+	bool addtocorrectchildregion(double x, double y);
+
+	//sets the aggregates from the point or from the aggregates of the children, O(1)
+	void updateAggregates();
 
 	//determines if the region is a leafelement
 	bool isLeaf() const;
@@ -101,8 +150,20 @@ private:
 	//merges this region
 	void merge();
 
-	//counts the total amount of points in this region
-	int countPoints() const;
+	//adds the points of this region to points
+	void collectPoints(std::vector<Point*>& points) const;
+
+	//adds the distances to p to total, returns false as soon as total + remaining*maxReach <= minTotal
+	bool addDistancesBounded(Point* p, double minTotal, double maxReach, int& remaining, double& total);
+
+	//adds the (approximate) distances to (x,y) to total and their possible error to maxError
+	void addApproximateDistances(double x, double y, double theta, double& total, double& maxError) const;
+
+	//upper bound of the total distance of (x,y) to the points of this region
+	double boundTotalDistance(double x, double y, double theta) const;
+
+	//depth first search for the point closest to (x,y), skips the regions that can't hold a point closer than closestDistance (squared)
+	void searchClosestPoint(double x, double y, Region*& closest, double& closestDistance);
 
 	//bepaalt de minimale afstand die de punten van deze regio tot het gegeven punt zullen hebben
 	double calcMinimumDistanceSquare(double x, double y);
@@ -114,4 +175,14 @@ private:
 
 };
 
+template <class RNG>
+double Region::getRandX(RNG& rng) const{
+	return rng.nextInt(int(xmax-xmin+1))+xmin;
+}
+
+template <class RNG>
+double Region::getRandY(RNG& rng) const{
+	return rng.nextInt(int(ymax-ymin+1))+ymin;
+}
+
 #endif
\ No newline at end of file
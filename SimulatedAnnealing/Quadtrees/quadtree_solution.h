@@ -10,39 +10,90 @@ class QuadtreeSolution
 {
 	
 	friend std::ostream& operator<<(std::ostream& output, const QuadtreeSolution& qts);
+	friend void writeCheckpoint(CheckpointWriter& writer, const QuadtreeSolution& solution);
+	friend bool readCheckpoint(CheckpointReader& reader, QuadtreeSolution& solution);
 
 public:
 
-	QuadtreeSolution(Region* regio);
+	template <class RNG> QuadtreeSolution(Region* regio, RNG& rng);
 	void setCurrentFurthest(Point * p);
 	Region* getRegion() const;
 	Point* getCurrentFurthest() const;
 
+	//in-place neighbour: move to the point closest to random coordinates, undoMove reverts it
+	template <class RNG> void moveToRandomPoint(RNG& rng);
+	void undoMove();
+
 private:
 	Point* currentFurthest;
+	Point* previousFurthest;
 	Region* region;
 };
 
-QuadtreeSolution::QuadtreeSolution(Region* region){
+template <class RNG>
+QuadtreeSolution::QuadtreeSolution(Region* region, RNG& rng){
 	this->region = region;
 	assert(!this->region->isEmpty());
-	Region* parent = region->findParentOfClosestPoint(region->getRandX(),region->getRandY());
+	Region* parent = region->findParentOfClosestPoint(region->getRandX(rng),region->getRandY(rng));
 	currentFurthest = parent->getPoint();
+	previousFurthest = currentFurthest;
 }
 
-void QuadtreeSolution::setCurrentFurthest(Point *p){
+inline void QuadtreeSolution::setCurrentFurthest(Point *p){
 	this->currentFurthest = p;
 }
 
-Region* QuadtreeSolution::getRegion() const{
+inline Region* QuadtreeSolution::getRegion() const{
 	return region;
 }
 
-Point* QuadtreeSolution::getCurrentFurthest() const{
+inline Point* QuadtreeSolution::getCurrentFurthest() const{
 	return currentFurthest;
 }
 
-std::ostream& operator<<(std::ostream& output, const QuadtreeSolution& qts){
+template <class RNG>
+void QuadtreeSolution::moveToRandomPoint(RNG& rng){
+	previousFurthest = currentFurthest;
+	Region* newParent = region->findParentOfClosestPoint(region->getRandX(rng), region->getRandY(rng));
+	if(newParent != 0){
+		currentFurthest = newParent->getPoint();
+	}
+}
+
+inline void QuadtreeSolution::undoMove(){
+	currentFurthest = previousFurthest;
+}
+
+//checkpoint hooks (see checkpoint.h), the region isn't part of the solution: the points are 
+//written by their coordinates and looked up again in the region of the solution read into 
+//(the region itself can be saved with Region::writeCheckpoint())
+inline void writeCheckpoint(CheckpointWriter& writer, const QuadtreeSolution& solution){
+	writer.write(solution.currentFurthest->getx());
+	writer.write(solution.currentFurthest->gety());
+	writer.write(solution.previousFurthest->getx());
+	writer.write(solution.previousFurthest->gety());
+}
+
+inline bool readCheckpoint(CheckpointReader& reader, QuadtreeSolution& solution){
+	double x = 0, y = 0, previousX = 0, previousY = 0;
+	reader.read(x);
+	reader.read(y);
+	reader.read(previousX);
+	reader.read(previousY);
+	if(!reader.good()){
+		return false;
+	}
+	Region* current = solution.region->findParentOfClosestPoint(x, y);
+	Region* previous = solution.region->findParentOfClosestPoint(previousX, previousY);
+	if(current == 0 || previous == 0){
+		return false;
+	}
+	solution.currentFurthest = current->getPoint();
+	solution.previousFurthest = previous->getPoint();
+	return solution.currentFurthest->getx() == x && solution.currentFurthest->gety() == y;
+}
+
+inline std::ostream& operator<<(std::ostream& output, const QuadtreeSolution& qts){
 	
 	std::cout << *qts.getCurrentFurthest() << std::endl;
 	std::cout << "Total Distance: " << qts.getRegion()->calcTotalDistance(qts.getCurrentFurthest()) << std::endl;
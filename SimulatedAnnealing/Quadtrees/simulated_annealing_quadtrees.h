@@ -0,0 +1,208 @@
+#ifndef __SIMULATED_ANNEALING_QUADTREES_H
+#define __SIMULATED_ANNEALING_QUADTREES_H
+
+#include "../simulated_annealing.h"
+#include "../static_simulated_annealing.h"
+#include "quadtree_solution.h"
+
+//the quadtree problem, shared by SimulatedAnnealingQuadtrees and StaticSimulatedAnnealingQuadtrees:
+//Base is the engine, whose hooks are overridden (SimulatedAnnealing) or hidden (StaticSimulatedAnnealing)
+template <class Base>
+class QuadtreeProblem:public Base{
+public:
+
+	typedef typename Base::NeighbourMode NeighbourMode;
+
+	QuadtreeSolution* giveRandomNeighbour (const QuadtreeSolution& lastSolution) const;
+
+	double calcDistanceToTarget (const QuadtreeSolution& solution) const;
+
+	void printStatus (const QuadtreeSolution& solution, double temp);
+
+	bool shouldStopHook(const QuadtreeSolution& solution);
+
+	NeighbourMode getNeighbourMode() const;
+
+	void proposeMove(const QuadtreeSolution& solution);
+
+	double calcMoveChange(const QuadtreeSolution& solution, double distance);
+
+	void commitMove(QuadtreeSolution& solution);
+
+	void discardMove();
+
+	bool useMaxChangeAcceptance() const;
+
+	double calcMoveChangeBounded(const QuadtreeSolution& solution, double distance, double maxChange);
+
+	void writeProblemState(CheckpointWriter& writer) const;
+
+	bool readProblemState(CheckpointReader& reader);
+
+	/**
+		Evaluates the total distances with Region::approximateTotalDistance() instead of 
+		summing over all points
+			@param theta 0 (the default) sums exactly, see Region::approximateTotalDistance()
+	*/
+	void setTheta(double theta);
+
+	QuadtreeProblem(const QuadtreeSolution& startSolution, const double& target, double starttemp, double precision, double alpha, uint64_t seed);
+
+private:
+	int counter;
+	Point* proposedFurthest; // point chosen by the last proposeMove
+	int nPoints; // number of points in the region, counted by the first bounded evaluation
+	double theta; // see setTheta()
+
+	double calcDistance(Region* region, Point* furthest) const;
+	double calcTotal(Region* region, Point* furthest, double& maxError) const;
+};
+
+template <class Base>
+QuadtreeSolution* QuadtreeProblem<Base>::giveRandomNeighbour(const QuadtreeSolution &lastSolution) const{
+
+	QuadtreeSolution* copy = this->copySolution(lastSolution);
+
+	double randX = lastSolution.getRegion()->getRandX(this->rng);
+	double randY = lastSolution.getRegion()->getRandY(this->rng);
+
+	Region* newParent  =  copy->getRegion()->findParentOfClosestPoint(randX, randY);
+	if(newParent != 0){
+		copy->setCurrentFurthest(newParent->getPoint());
+	}
+	
+	return copy;
+}
+
+template <class Base>
+double QuadtreeProblem<Base>::calcDistanceToTarget(const QuadtreeSolution &solution) const{
+	return calcDistance(solution.getRegion(), solution.getCurrentFurthest());
+}
+
+template <class Base>
+double QuadtreeProblem<Base>::calcDistance(Region* region, Point* furthest) const{
+	double maxError;
+	double distance = calcTotal(region, furthest, maxError);
+	if(distance == 0){
+		return 2;
+	}else{
+		return 1/distance;
+	}
+}
+
+template <class Base>
+double QuadtreeProblem<Base>::calcTotal(Region* region, Point* furthest, double& maxError) const{
+	if(theta > 0){
+		return region->approximateTotalDistance(furthest, theta, maxError);
+	}
+	maxError = 0;
+	return region->calcTotalDistance(furthest);
+}
+
+template <class Base>
+void QuadtreeProblem<Base>::printStatus(const QuadtreeSolution &solution, double temp){
+	Region* region = solution.getRegion();
+	double maxError;
+	double distance = calcTotal(region, solution.getCurrentFurthest(), maxError);
+
+	std::ostringstream line;
+	line << "Temp: " << temp << " Total Distance: " << distance;
+	if(maxError > 0){
+		line << " (+-" << maxError << ")";
+	}
+	line << " Counter: " << counter 
+		<< " Current Furthest: (" << solution.getCurrentFurthest()->getx() << "," << solution.getCurrentFurthest()->gety() << ")";
+	this->writeLog(line.str());
+}
+
+template <class Base>
+bool QuadtreeProblem<Base>::shouldStopHook(const QuadtreeSolution &solution){
+	counter++;
+	return counter >= 500;
+}
+
+template <class Base>
+typename QuadtreeProblem<Base>::NeighbourMode QuadtreeProblem<Base>::getNeighbourMode() const{
+	return Base::MOVE_NEIGHBOUR;
+}
+
+template <class Base>
+void QuadtreeProblem<Base>::proposeMove(const QuadtreeSolution &solution){
+	Region* region = solution.getRegion();
+	Region* newParent = region->findParentOfClosestPoint(region->getRandX(this->rng), region->getRandY(this->rng));
+	if(newParent != 0){
+		proposedFurthest = newParent->getPoint();
+	}else{
+		proposedFurthest = solution.getCurrentFurthest();
+	}
+}
+
+template <class Base>
+double QuadtreeProblem<Base>::calcMoveChange(const QuadtreeSolution &solution, double distance){
+	return calcDistance(solution.getRegion(), proposedFurthest) - distance;
+}
+
+template <class Base>
+void QuadtreeProblem<Base>::commitMove(QuadtreeSolution &solution){
+	solution.setCurrentFurthest(proposedFurthest);
+	proposedFurthest = 0;
+}
+
+template <class Base>
+void QuadtreeProblem<Base>::discardMove(){
+	proposedFurthest = 0;
+}
+
+template <class Base>
+bool QuadtreeProblem<Base>::useMaxChangeAcceptance() const{
+	return true;
+}
+
+template <class Base>
+double QuadtreeProblem<Base>::calcMoveChangeBounded(const QuadtreeSolution &solution, double distance, double maxChange){
+	if(theta > 0){
+		//the approximation doesn't visit every point, there's nothing to stop early
+		return calcMoveChange(solution, distance);
+	}
+	//the move is discarded when 1/total >= distance+maxChange, so summing can stop once total can't get above 1/(distance+maxChange)
+	if(nPoints < 0){
+		nPoints = solution.getRegion()->getPointCount();
+	}
+	double total = solution.getRegion()->calcTotalDistance(proposedFurthest, 1/(distance+maxChange), nPoints);
+	return (total == 0 ? 2 : 1/total) - distance;
+}
+
+template <class Base>
+void QuadtreeProblem<Base>::writeProblemState(CheckpointWriter& writer) const{
+	writer.write(counter);
+}
+
+template <class Base>
+bool QuadtreeProblem<Base>::readProblemState(CheckpointReader& reader){
+	return reader.read(counter);
+}
+
+template <class Base>
+void QuadtreeProblem<Base>::setTheta(double theta){
+	assert(theta >= 0);
+	this->theta = theta;
+}
+
+template <class Base>
+QuadtreeProblem<Base>::QuadtreeProblem(const QuadtreeSolution& startSolution, const double& target, 
+														 double starttemp, double precision, double alpha, uint64_t seed):Base(startSolution, target, starttemp, precision, alpha, seed), counter(0), proposedFurthest(0), nPoints(-1), theta(0){
+
+}
+
+class SimulatedAnnealingQuadtrees:public QuadtreeProblem<SimulatedAnnealing<QuadtreeSolution, double> >{
+public:
+	SimulatedAnnealingQuadtrees(const QuadtreeSolution& startSolution, const double& target, double starttemp, double precision, double alpha, uint64_t seed = 0):QuadtreeProblem(startSolution, target, starttemp, precision, alpha, seed){};
+};
+
+//same problem using StaticSimulatedAnnealing, the hooks are resolved at compile time
+class StaticSimulatedAnnealingQuadtrees:public QuadtreeProblem<StaticSimulatedAnnealing<StaticSimulatedAnnealingQuadtrees, QuadtreeSolution, double> >{
+public:
+	StaticSimulatedAnnealingQuadtrees(const QuadtreeSolution& startSolution, const double& target, double starttemp, double precision, double alpha, uint64_t seed = 0):QuadtreeProblem(startSolution, target, starttemp, precision, alpha, seed){};
+};
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef __SIMULATED_ANNEALING_SIN_H
+#define __SIMULATED_ANNEALING_SIN_H
+
+#include "../simulated_annealing.h"
+#include "../static_simulated_annealing.h"
+#include "../batched_simulated_annealing.h"
+
+#define PI 3.14159265
+
+/******************************************************************//**
+
+   SimulatedAnnealingSin
+
+   Example of the use of the SimulatedAnnealing class
+   Will try to find an angle at which sin(x) is (close to) 1 
+   using Simulated Annealing
+
+   
+***************************************************************************/
+
+//the sin problem, shared by SimulatedAnnealingSin and StaticSimulatedAnnealingSin: Base is the 
+//engine, whose hooks are overridden (SimulatedAnnealing) or hidden (StaticSimulatedAnnealing)
+template <class Base>
+class SinProblem:public Base{
+public:
+	
+	double* giveRandomNeighbour(const double& lastSolution) const;
+
+	double calcDistanceToTarget(const double& solution) const;
+
+//	void printStatus(double solution, double temp);
+
+	//in-place interface, only used when getNeighbourMode() returns IN_PLACE_NEIGHBOUR
+	void applyRandomMove(double& angle);
+
+	void undoMove(double& angle);
+
+	SinProblem(const double& startSolution, const double& target, double starttemp, double precision, double alpha, uint64_t seed):Base(startSolution, target, starttemp, precision, alpha, seed), lastAngle(startSolution){};
+
+protected:
+	
+	double calcSin(const double& degrees) const;
+
+private:
+	double lastAngle; // angle before the last applyRandomMove
+
+};
+
+template <class Base>
+double SinProblem<Base>::calcSin(const double& degrees) const{ // specific for problem
+
+	return sin(1.0*degrees*(PI)/180);
+
+}
+
+template <class Base>
+double* SinProblem<Base>::giveRandomNeighbour(const double& lastAngle) const{ // should be overwritten
+	
+	int randomDegrees = this->rng.nextInt(21) - 10; // will look for a random neighbour within 10 degrees
+	double* newAngle = this->copySolution(lastAngle);
+	*newAngle += randomDegrees;
+	return newAngle;
+
+}
+
+template <class Base>
+double SinProblem<Base>::calcDistanceToTarget(const double& angle) const{ // should be overwritten
+
+	double distance = calcSin(angle)-*this->TARGET;
+	if(distance > 0){
+		return distance;
+	}else{
+		return (-distance);
+	}
+
+}
+
+template <class Base>
+void SinProblem<Base>::applyRandomMove(double& angle){
+	lastAngle = angle;
+	angle += this->rng.nextInt(21) - 10; // will look for a random neighbour within 10 degrees
+}
+
+template <class Base>
+void SinProblem<Base>::undoMove(double& angle){
+	angle = lastAngle;
+}
+
+class SimulatedAnnealingSin:public SinProblem<SimulatedAnnealing<double, double> >{
+public:
+	SimulatedAnnealingSin(const double& startSolution, const double& target, double starttemp, double precision, double alpha, uint64_t seed = 0):SinProblem(startSolution, target, starttemp, precision, alpha, seed){};
+};
+
+
+
+/******************************************************************//**
+
+   StaticSimulatedAnnealingSin
+
+   The same problem using StaticSimulatedAnnealing, the hooks are resolved 
+   at compile time and the angle is changed in place, so the search loop 
+   has no virtual calls and no allocations left
+
+***************************************************************************/
+
+class StaticSimulatedAnnealingSin:public SinProblem<StaticSimulatedAnnealing<StaticSimulatedAnnealingSin, double, double> >{
+public:
+
+	NeighbourMode getNeighbourMode() const;
+
+	StaticSimulatedAnnealingSin(const double& startSolution, const double& target, double starttemp, double precision, double alpha, uint64_t seed = 0):SinProblem(startSolution, target, starttemp, precision, alpha, seed){};
+
+};
+
+inline StaticSimulatedAnnealingSin::NeighbourMode StaticSimulatedAnnealingSin::getNeighbourMode() const{
+	return IN_PLACE_NEIGHBOUR;
+}
+
+
+
+/******************************************************************//**
+
+   SinBatchProblem
+
+   The same problem for BatchedSimulatedAnnealing, which runs many 
+   chains at once in SIMD lanes: the neighbours and distances of all 
+   lanes are calculated in one loop each
+
+***************************************************************************/
+
+class SinBatchProblem{
+public:
+
+	explicit SinBatchProblem(double target):target(target){}
+
+	void calcNeighbours(const double* angles, const double* uniforms, double* candidates, int n) const{
+		for(int i=0; i<n; i++){
+			candidates[i] = angles[i] + (int)(uniforms[i]*21) - 10; // a random neighbour within 10 degrees
+		}
+	}
+
+	void calcDistances(const double* angles, double* distances, int n) const{
+		for(int i=0; i<n; i++){
+			distances[i] = fabs(batchSin(angles[i]*(PI/180)) - target);
+		}
+	}
+
+private:
+	double target;
+
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef __ACCEPTANCE_RULES_H
+#define __ACCEPTANCE_RULES_H
+
+#include <cmath>
+#include <assert.h>
+
+
+
+/***********************************************************************************************//**
+
+	\brief Acceptance rules for the Simulated Annealing Framework
+
+	An acceptance rule is a policy class given as template parameter to (Static)SimulatedAnnealing,
+	the standard calcProbability() asks it for the probability with which an uphill move is
+	accepted (improvements are always accepted). Because the rule is known at compile time its
+	call is inlined, choosing another rule costs nothing at run time.
+
+	An acceptance rule has to be default constructible (parameters can be changed through
+	setAcceptance()) and offer:
+	- double probability(double change, double distance, double temp) const
+	  with change the (positive) change in distance, distance the distance of the current
+	  solution and temp the current temperature. The result has to be in [0,1].
+	- double maxChange(double distance, double temp, double e) const
+	  the same rule turned around for the max change acceptance test (see useMaxChangeAcceptance() 
+	  in simulated_annealing.h): with e an exponentially distributed value \f$ -ln(u) \f$ it 
+	  returns the change below which a move is accepted, so that 
+	  \f$ P(\Delta < maxChange) \f$ equals probability(\Delta, distance, temp). 
+	  No exp() is needed per move and the candidate can be evaluated against this bound.
+
+***************************************************************************************************/
+
+/**
+	\f$ P = exp(\frac{-\Delta}{T}) \f$, at T = 0 (e.g. the end of LinearCooling) only improvements
+	are accepted
+*/
+class MetropolisAcceptance{
+public:
+	double probability(double change, double distance, double temp) const{
+		if(temp <= 0){
+			return 0;
+		}
+		return exp(-1.0*change/temp);
+	}
+	//\f$ u < exp(\frac{-\Delta}{T}) \Leftrightarrow \Delta < -T ln(u) \f$
+	double maxChange(double distance, double temp, double e) const{
+		return temp*e;
+	}
+};
+
+/**
+	Threshold accepting (Dueck & Scheuer): every move that is less than T worse is accepted
+*/
+class ThresholdAcceptance{
+public:
+	double probability(double change, double distance, double temp) const{
+		return change < temp ? 1 : 0;
+	}
+	double maxChange(double distance, double temp, double e) const{
+		return temp;
+	}
+};
+
+/**
+	Great deluge (Dueck): the temperature is used as water level, every solution with a
+	distance below it is accepted. Use a cooling schedule that lowers the level slowly
+	(e.g. LinearCooling) and start at a level above the distance of the start solution.
+*/
+class GreatDelugeAcceptance{
+public:
+	double probability(double change, double distance, double temp) const{
+		return distance+change < temp ? 1 : 0;
+	}
+	double maxChange(double distance, double temp, double e) const{
+		return temp-distance;
+	}
+};
+
+/**
+	Tsallis (generalized simulated annealing):
+	\f$ P = (1 + (q-1)\frac{\Delta}{T})^{\frac{-1}{q-1}} \f$,
+	heavier tailed than Metropolis for q > 1 and equal to it in the limit q = 1
+*/
+class TsallisAcceptance{
+public:
+	explicit TsallisAcceptance(double q = 1.5):q(q){
+		assert(q >= 1);
+	}
+	double probability(double change, double distance, double temp) const{
+		if(temp <= 0){
+			return 0;
+		}
+		if(q == 1){
+			return exp(-1.0*change/temp);
+		}
+		return pow(1 + (q-1)*change/temp, -1.0/(q-1));
+	}
+	//\f$ u < (1 + (q-1)\frac{\Delta}{T})^{\frac{-1}{q-1}} \Leftrightarrow \Delta < T\frac{u^{1-q}-1}{q-1} \f$
+	double maxChange(double distance, double temp, double e) const{
+		if(q == 1){
+			return temp*e;
+		}
+		return temp*(exp((q-1)*e)-1)/(q-1);
+	}
+private:
+	double q;
+};
+
+#endif
@@ -0,0 +1,334 @@
+#ifndef __BATCHED_SIMULATED_ANNEALING_H
+#define __BATCHED_SIMULATED_ANNEALING_H
+
+#include <cmath>	// needed for chance calculation
+#include <cstring>	// needed for memcpy
+#include <cfloat>	// needed for DBL_MAX
+#include <stdint.h>	// needed for fixed size integers
+#include <assert.h>
+#include "random_engine.h"	// BatchXoshiro256
+#include "cooling_schedules.h"
+
+
+
+/***********************************************************************************************//**
+
+	\brief Simulated Annealing Framework, lane-batched variant for scalar continuous problems
+
+	Batched Simulated Annealing Class
+
+	Runs LANES independent chains of a problem whose solution is a single double (like
+	SimulatedAnnealingSin) side by side. The state of the chains is kept as structure of arrays
+	and every step() does the same work for all of them in straight loops without branches:
+	one BatchXoshiro256 call draws the random numbers of all lanes, the problem generates and
+	evaluates all candidates at once and the Metropolis test is turned into a select. The
+	compiler can then put the lanes in SIMD registers (4 doubles with AVX2, 8 with AVX-512),
+	for problems this cheap that gives far more chain steps per second than running the
+	chains one after the other through StaticSimulatedAnnealing.
+
+	The chains share the temperature, which follows the Cooling policy (see
+	cooling_schedules.h) and is lowered by coolDown().
+
+	A Problem has to offer (both are called with n == LANES):
+	- void calcNeighbours(const double* solutions, const double* uniforms, double* candidates, int n) const
+	  a random neighbour of every solution, uniforms holds one random number in [0,1) per lane
+	- void calcDistances(const double* solutions, double* distances, int n) const
+	  the distance to the target of every solution
+	Both should be inline loops without branches, otherwise the lanes are simply run one by one.
+	Calls of the standard math functions are such branches unless the compiler may use a vector
+	math library (gcc only does so with -ffast-math), batchExp() and batchSin() below are
+	straight-line replacements that vectorise with any flags.
+
+***************************************************************************************************/
+
+/**
+	exp(x) without branches or calls, relative error below 1e-14. |x| is limited to 708, so
+	arguments below -708 give exp(-708) (about 3e-308) instead of smaller numbers or 0.
+*/
+inline double batchExp(double x){
+	//|x| = min(|x|, 708) on the bits, a compare would be turned into a branch around the rest
+	uint64_t xBits;
+	memcpy(&xBits, &x, sizeof(double));
+	int64_t overshoot = (int64_t)(xBits & 0x7FFFFFFFFFFFFFFFULL) - 0x4086200000000000LL;
+	xBits -= (uint64_t)(overshoot & ~(overshoot >> 63));
+	memcpy(&x, &xBits, sizeof(double));
+	//x = n*ln(2) + r with |r| <= ln(2)/2, exp(x) = 2^n * exp(r), adding 1.5*2^52 rounds x/ln(2)
+	//to the integer n in the low bits of the mantissa (floor() only vectorises with -ffast-math)
+	double shifted = x*1.4426950408889634 + 6755399441055744.0;
+	uint64_t bits;
+	memcpy(&bits, &shifted, sizeof(double));
+	double n = (double)(int32_t)bits;
+	double r = x - n*0.693145751953125 - n*1.4286068203094173e-06;
+	double p = 1/39916800.0;
+	p = p*r + 1/3628800.0;
+	p = p*r + 1/362880.0;
+	p = p*r + 1/40320.0;
+	p = p*r + 1/5040.0;
+	p = p*r + 1/720.0;
+	p = p*r + 1/120.0;
+	p = p*r + 1/24.0;
+	p = p*r + 1/6.0;
+	p = p*r + 0.5;
+	p = p*r + 1;
+	p = p*r + 1;
+	//2^n built from its bits
+	bits = (bits + 1023) << 52;
+	double scale;
+	memcpy(&scale, &bits, sizeof(double));
+	return p*scale;
+}
+
+/**
+	sin(x) without branches or calls, absolute error below 1e-15 for |x| < 10 that grows with |x|
+	(about 4e-14 at 1000) because the reduction by multiples of pi loses precision
+*/
+inline double batchSin(double x){
+	//x = k*pi + r with |r| <= pi/2, sin(x) = (-1)^k * sin(r), k is rounded like n in batchExp()
+	double shifted = x*0.3183098861837907 + 6755399441055744.0;
+	uint64_t bits;
+	memcpy(&bits, &shifted, sizeof(double));
+	double k = (double)(int32_t)bits;
+	double r = x - k*3.1415926218032837 - k*3.178650954705639e-08 - k*1.2246467991473532e-16;
+	double r2 = r*r;
+	double p = -1/121645100408832000.0;
+	p = p*r2 + 1/355687428096000.0;
+	p = p*r2 - 1/1307674368000.0;
+	p = p*r2 + 1/6227020800.0;
+	p = p*r2 - 1/39916800.0;
+	p = p*r2 + 1/362880.0;
+	p = p*r2 - 1/5040.0;
+	p = p*r2 + 1/120.0;
+	p = p*r2 - 1/6.0;
+	p = p*r2 + 1;
+	double result = p*r;
+	//odd k flips the sign bit
+	uint64_t resultBits;
+	memcpy(&resultBits, &result, sizeof(double));
+	resultBits ^= bits << 63;
+	memcpy(&result, &resultBits, sizeof(double));
+	return result;
+}
+
+template <class Problem, int LANES = 8, class Cooling = GeometricCooling>
+class BatchedSimulatedAnnealing{
+
+public:
+
+	/**
+		Constructor
+			@param problem The problem, copied
+			@param startSolutions The start solution of every lane (LANES values)
+			@param starttemp The starttemperature
+			@param PRECISION The required PRECISION for a solution to be acceptable
+			@param alpha The main parameter of the cooling schedule
+			@param seed The seed of the random number engine, lane i uses seed+i
+	*/
+	BatchedSimulatedAnnealing(const Problem& problem, const double* startSolutions, double starttemp, double precision, double alpha, uint64_t seed = 0);
+
+	/**
+		(Re)calculates the distances of the current solutions, has to be called once before the
+		first step() (solve() does this itself)
+	*/
+	void evaluateSolutions();
+
+	/**
+		Does one iteration of every lane at the current temperature
+			@return The number of lanes that accepted their neighbour
+	*/
+	int step();
+
+	/**
+		Lowers the temperature with the cooling schedule
+	*/
+	void coolDown();
+
+	/**
+		Steps and cools down until one of the lanes is within PRECISION of the target or the
+		number of iterations is done
+			@param maxIterations The maximum number of iterations (per lane)
+			@return The lane with the best solution found
+	*/
+	int solve(long maxIterations);
+
+	/**
+		@return Whether or not one of the lanes is within PRECISION of the target
+	*/
+	bool reachedPrecision() const;
+
+	double getSolution(int lane) const;
+	double getDistance(int lane) const;
+
+	/**
+		The best solution every lane has seen, updated by step()
+	*/
+	double getBestSolution(int lane) const;
+	double getBestDistance(int lane) const;
+
+	//lane with the lowest best distance
+	int getBestLane() const;
+
+	double getTemp() const;
+	void setTemp(double temp);
+
+	long getIteration() const;
+
+	static int getLanes(){
+		return LANES;
+	}
+
+private:
+	Problem problem;
+	const double PRECISION;
+	const double START_TEMP;
+	double temp;
+	long iteration;
+	bool lastAccepted;
+	Cooling cooling;
+	BatchXoshiro256<LANES> rng;
+
+	alignas(64) double solution[LANES];
+	alignas(64) double distance[LANES];
+	alignas(64) double candidate[LANES];
+	alignas(64) double candidateDistance[LANES];
+	alignas(64) double bestSolution[LANES];
+	alignas(64) double bestDistance[LANES];
+	alignas(64) double uniform[LANES];
+	alignas(64) uint64_t bits[LANES];
+	alignas(64) uint64_t acceptedLanes[LANES];
+
+	void drawUniforms();
+};
+
+template <class Problem, int LANES, class Cooling>
+BatchedSimulatedAnnealing<Problem,LANES,Cooling>::BatchedSimulatedAnnealing(const Problem& problem, const double* startSolutions, double starttemp, double precision, double alpha, uint64_t seed)
+		:problem(problem),PRECISION(precision),START_TEMP(starttemp),temp(starttemp),iteration(0),lastAccepted(false),cooling(alpha),rng(seed){
+	assert(starttemp > 0);
+	assert(precision >= 0);
+	for(int i=0; i<LANES; i++){
+		solution[i] = startSolutions[i];
+	}
+	evaluateSolutions();
+}
+
+template <class Problem, int LANES, class Cooling>
+void BatchedSimulatedAnnealing<Problem,LANES,Cooling>::evaluateSolutions(){
+	problem.calcDistances(solution, distance, LANES);
+	for(int i=0; i<LANES; i++){
+		bestSolution[i] = solution[i];
+		bestDistance[i] = distance[i];
+	}
+}
+
+template <class Problem, int LANES, class Cooling>
+inline void BatchedSimulatedAnnealing<Problem,LANES,Cooling>::drawUniforms(){
+	rng.next(bits);
+	BatchXoshiro256<LANES>::toDouble(bits, uniform);
+}
+
+template <class Problem, int LANES, class Cooling>
+int BatchedSimulatedAnnealing<Problem,LANES,Cooling>::step(){
+	iteration++;
+
+	drawUniforms();
+	problem.calcNeighbours(solution, uniform, candidate, LANES);
+	problem.calcDistances(candidate, candidateDistance, LANES);
+
+	//Metropolis for all lanes: accept with chance exp(-change/temp), downhill moves get chance 1
+	drawUniforms();
+	const double invTemp = temp > 0 ? 1/temp : DBL_MAX;
+	for(int i=0; i<LANES; i++){
+		double change = candidateDistance[i] - distance[i];
+		double chance = batchExp(-(change > 0 ? change : 0)*invTemp);
+		bool accept = uniform[i] < chance;
+		solution[i] = accept ? candidate[i] : solution[i];
+		distance[i] = accept ? candidateDistance[i] : distance[i];
+		acceptedLanes[i] = accept ? 1 : 0;
+	}
+	int accepted = 0;
+	for(int i=0; i<LANES; i++){
+		bool better = distance[i] < bestDistance[i];
+		bestSolution[i] = better ? solution[i] : bestSolution[i];
+		bestDistance[i] = better ? distance[i] : bestDistance[i];
+		accepted += (int)acceptedLanes[i];
+	}
+
+	lastAccepted = accepted > 0;
+	return accepted;
+}
+
+template <class Problem, int LANES, class Cooling>
+void BatchedSimulatedAnnealing<Problem,LANES,Cooling>::coolDown(){
+	CoolingState state = {START_TEMP, iteration, lastAccepted};
+	temp = cooling.next(temp, state);
+}
+
+template <class Problem, int LANES, class Cooling>
+int BatchedSimulatedAnnealing<Problem,LANES,Cooling>::solve(long maxIterations){
+	evaluateSolutions();
+	for(long i=0; i<maxIterations && !reachedPrecision(); i++){
+		step();
+		coolDown();
+	}
+	return getBestLane();
+}
+
+template <class Problem, int LANES, class Cooling>
+bool BatchedSimulatedAnnealing<Problem,LANES,Cooling>::reachedPrecision() const{
+	int reached = 0;
+	for(int i=0; i<LANES; i++){
+		reached += distance[i] <= PRECISION ? 1 : 0;
+	}
+	return reached > 0;
+}
+
+template <class Problem, int LANES, class Cooling>
+double BatchedSimulatedAnnealing<Problem,LANES,Cooling>::getSolution(int lane) const{
+	assert(lane >= 0 && lane < LANES);
+	return solution[lane];
+}
+
+template <class Problem, int LANES, class Cooling>
+double BatchedSimulatedAnnealing<Problem,LANES,Cooling>::getDistance(int lane) const{
+	assert(lane >= 0 && lane < LANES);
+	return distance[lane];
+}
+
+template <class Problem, int LANES, class Cooling>
+double BatchedSimulatedAnnealing<Problem,LANES,Cooling>::getBestSolution(int lane) const{
+	assert(lane >= 0 && lane < LANES);
+	return bestSolution[lane];
+}
+
+template <class Problem, int LANES, class Cooling>
+double BatchedSimulatedAnnealing<Problem,LANES,Cooling>::getBestDistance(int lane) const{
+	assert(lane >= 0 && lane < LANES);
+	return bestDistance[lane];
+}
+
+template <class Problem, int LANES, class Cooling>
+int BatchedSimulatedAnnealing<Problem,LANES,Cooling>::getBestLane() const{
+	int best = 0;
+	for(int i=1; i<LANES; i++){
+		if(bestDistance[i] < bestDistance[best]){
+			best = i;
+		}
+	}
+	return best;
+}
+
+template <class Problem, int LANES, class Cooling>
+double BatchedSimulatedAnnealing<Problem,LANES,Cooling>::getTemp() const{
+	return temp;
+}
+
+template <class Problem, int LANES, class Cooling>
+void BatchedSimulatedAnnealing<Problem,LANES,Cooling>::setTemp(double temp){
+	this->temp = temp;
+}
+
+template <class Problem, int LANES, class Cooling>
+long BatchedSimulatedAnnealing<Problem,LANES,Cooling>::getIteration() const{
+	return iteration;
+}
+
+#endif
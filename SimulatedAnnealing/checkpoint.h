@@ -0,0 +1,266 @@
+#ifndef __CHECKPOINT_H
+#define __CHECKPOINT_H
+
+#include <vector>
+#include <stdint.h>	// needed for fixed size integers
+#include <string>
+#include <cstdio>	// needed for the file functions
+#include <cstring>	// needed for memcpy
+#include <type_traits>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <assert.h>
+
+
+
+/***********************************************************************************************//**
+
+	\brief Binary checkpoints for the Simulated Annealing Framework
+
+	A checkpoint is a compact binary snapshot of a (Static)SimulatedAnnealing object (see
+	saveCheckpoint() and loadCheckpoint()), loading it into an object of the same problem
+	constructed with the same parameters continues the run exactly where it was saved.
+
+	Solution types are written with a serialization hook, a pair of functions found by overload
+	resolution:
+	- void writeCheckpoint(CheckpointWriter& writer, const Solution& solution)
+	- bool readCheckpoint(CheckpointReader& reader, Solution& solution)
+	  reads into an existing object (e.g. a copy of the start solution), returns false when
+	  the data doesn't fit the object
+	This file has the hook for double, the problems have theirs next to their solution class.
+
+	The data is native byte order, a checkpoint is meant to be loaded on the machine (type)
+	that wrote it.
+
+***************************************************************************************************/
+
+//first bytes of a checkpoint of a (Static)SimulatedAnnealing object, "SAC1"
+const uint32_t CHECKPOINT_MAGIC = 0x31434153;
+
+class CheckpointWriter{
+
+public:
+
+	void writeBytes(const void* data, size_t size){
+		const char* bytes = (const char*)data;
+		buffer.insert(buffer.end(), bytes, bytes+size);
+	}
+
+	/**
+		Writes the bytes of a trivially copyable object (numbers, random engines, policies, ...)
+	*/
+	template <class T> void write(const T& value){
+		static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable types can be written as bytes");
+		writeBytes(&value, sizeof(T));
+	}
+
+	const std::vector<char>& getBuffer() const{
+		return buffer;
+	}
+
+	std::vector<char>& getBuffer(){
+		return buffer;
+	}
+
+private:
+	std::vector<char> buffer;
+
+};
+
+class CheckpointReader{
+
+public:
+
+	explicit CheckpointReader(const std::vector<char>& buffer):buffer(buffer),position(0),failed(false){}
+
+	/**
+		@return false (and marks the reader as failed) when there aren't enough bytes left
+	*/
+	bool readBytes(void* data, size_t size){
+		if(failed || buffer.size()-position < size){
+			failed = true;
+			return false;
+		}
+		memcpy(data, &buffer[0]+position, size);
+		position += size;
+		return true;
+	}
+
+	template <class T> bool read(T& value){
+		static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable types can be read as bytes");
+		return readBytes(&value, sizeof(T));
+	}
+
+	//whether or not every read so far succeeded
+	bool good() const{
+		return !failed;
+	}
+
+	bool atEnd() const{
+		return position == buffer.size();
+	}
+
+private:
+	const std::vector<char>& buffer;
+	size_t position;
+	bool failed;
+
+};
+
+inline void writeCheckpoint(CheckpointWriter& writer, const double& solution){
+	writer.write(solution);
+}
+
+inline bool readCheckpoint(CheckpointReader& reader, double& solution){
+	return reader.read(solution);
+}
+
+/**
+	Writes the buffer to a temporary file next to path which then replaces path, so a crash
+	while writing never leaves a half written checkpoint behind
+		@return Whether or not the checkpoint was written
+*/
+inline bool writeCheckpointFile(const std::string& path, const std::vector<char>& buffer){
+	std::string temporary = path + ".tmp";
+	FILE* file = fopen(temporary.c_str(), "wb");
+	if(file == 0){
+		return false;
+	}
+	bool written = buffer.empty() || fwrite(&buffer[0], 1, buffer.size(), file) == buffer.size();
+	written = fflush(file) == 0 && written;
+	written = fclose(file) == 0 && written;
+	if(!written){
+		remove(temporary.c_str());
+		return false;
+	}
+#ifdef _WIN32
+	remove(path.c_str()); // rename doesn't replace existing files on windows
+#endif
+	return rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+inline bool readCheckpointFile(const std::string& path, std::vector<char>& buffer){
+	FILE* file = fopen(path.c_str(), "rb");
+	if(file == 0){
+		return false;
+	}
+	buffer.clear();
+	char block[4096];
+	size_t read;
+	while((read = fread(block, 1, sizeof(block), file)) > 0){
+		buffer.insert(buffer.end(), block, block+read);
+	}
+	bool ok = ferror(file) == 0;
+	fclose(file);
+	return ok;
+}
+
+/**
+	Writes checkpoints from a background thread so the search only pays for making the snapshot
+	in memory. When a new snapshot arrives before the previous one was written, only the newest
+	one is written.
+*/
+class AsyncCheckpointWriter{
+
+public:
+
+	explicit AsyncCheckpointWriter(const std::string& path);
+
+	/**
+		Writes the last submitted snapshot and stops the background thread
+	*/
+	~AsyncCheckpointWriter();
+
+	/**
+		Hands a snapshot to the background thread, the buffer is taken over (and left empty)
+	*/
+	void submit(std::vector<char>& buffer);
+
+	/**
+		Blocks until every submitted snapshot has been written
+	*/
+	void flush();
+
+	//number of snapshots that could not be written
+	unsigned long getFailures() const;
+
+private:
+	const std::string path;
+	mutable std::mutex mutex;
+	std::condition_variable changed;
+	std::vector<char> pending;
+	bool hasPending;
+	bool writing;
+	bool stopping;
+	unsigned long failures;
+	std::thread worker;
+
+	void work();
+
+	AsyncCheckpointWriter(const AsyncCheckpointWriter&);
+	AsyncCheckpointWriter& operator=(const AsyncCheckpointWriter&);
+};
+
+inline AsyncCheckpointWriter::AsyncCheckpointWriter(const std::string& path):path(path),hasPending(false),writing(false),stopping(false),failures(0){
+	worker = std::thread(&AsyncCheckpointWriter::work, this);
+}
+
+inline AsyncCheckpointWriter::~AsyncCheckpointWriter(){
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	changed.notify_all();
+	worker.join();
+}
+
+inline void AsyncCheckpointWriter::submit(std::vector<char>& buffer){
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		pending.swap(buffer);
+		hasPending = true;
+	}
+	buffer.clear();
+	changed.notify_all();
+}
+
+inline void AsyncCheckpointWriter::flush(){
+	std::unique_lock<std::mutex> lock(mutex);
+	while(hasPending || writing){
+		changed.wait(lock);
+	}
+}
+
+inline unsigned long AsyncCheckpointWriter::getFailures() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return failures;
+}
+
+inline void AsyncCheckpointWriter::work(){
+	std::vector<char> buffer;
+	std::unique_lock<std::mutex> lock(mutex);
+	while(true){
+		while(!hasPending && !stopping){
+			changed.wait(lock);
+		}
+		if(!hasPending){ // stopping and nothing left to write
+			return;
+		}
+		buffer.swap(pending);
+		hasPending = false;
+		writing = true;
+
+		lock.unlock();
+		bool written = writeCheckpointFile(path, buffer);
+		lock.lock();
+
+		if(!written){
+			failures++;
+		}
+		writing = false;
+		changed.notify_all();
+	}
+}
+
+#endif
@@ -0,0 +1,187 @@
+#ifndef __COOLING_SCHEDULES_H
+#define __COOLING_SCHEDULES_H
+
+#include <cmath>
+#include <assert.h>
+
+
+
+/***********************************************************************************************//**
+
+	\brief Cooling schedules for the Simulated Annealing Framework
+
+	A cooling schedule is a policy class given as template parameter to (Static)SimulatedAnnealing,
+	the standard calcNewTemp() asks it for the next temperature. Because the schedule is known at
+	compile time its call is inlined, choosing another schedule costs nothing at run time.
+
+	A cooling schedule has to offer:
+	- a constructor taking one double, the alpha passed to the SimulatedAnnealing constructor is
+	  handed to it as the main parameter of the schedule (other parameters have defaults and can
+	  be changed through setCooling())
+	- double next(double temp, const CoolingState& state)
+	- double advance(double temp, const CoolingState& state, long iterations), the temperature
+	  after a number of iterations of which all but the last were rejected, asked after a
+	  rejection-free step (state is the one after the last of them)
+
+***************************************************************************************************/
+
+/**
+	What a cooling schedule gets to know about the search
+*/
+struct CoolingState{
+	double startTemp;	// the temperature the search started with
+	long iteration;		// the number of iterations done so far
+	bool accepted;		// whether or not the last neighbour was accepted
+};
+
+/**
+	\f$ T_{k+1} = \alpha T_k \f$
+*/
+class GeometricCooling{
+public:
+	explicit GeometricCooling(double alpha):alpha(alpha){}
+	double next(double temp, const CoolingState& state){
+		return temp*alpha;
+	}
+	double advance(double temp, const CoolingState& state, long iterations){
+		return temp*pow(alpha, (double)iterations);
+	}
+private:
+	double alpha;
+};
+
+/**
+	\f$ T_{k+1} = max(T_k - \delta, 0) \f$
+*/
+class LinearCooling{
+public:
+	explicit LinearCooling(double delta):delta(delta){}
+	double next(double temp, const CoolingState& state){
+		return temp > delta ? temp-delta : 0;
+	}
+	double advance(double temp, const CoolingState& state, long iterations){
+		return temp > iterations*delta ? temp-iterations*delta : 0;
+	}
+private:
+	double delta;
+};
+
+/**
+	\f$ T_k = \frac{T_0}{1 + c \cdot ln(1+k)} \f$, the slow schedule of the convergence proofs
+*/
+class LogarithmicCooling{
+public:
+	explicit LogarithmicCooling(double c):c(c){}
+	double next(double temp, const CoolingState& state){
+		return state.startTemp/(1 + c*log(1.0 + state.iteration));
+	}
+	double advance(double temp, const CoolingState& state, long iterations){
+		return next(temp, state);
+	}
+private:
+	double c;
+};
+
+/**
+	Lundy & Mees: \f$ T_{k+1} = \frac{T_k}{1 + \beta T_k} \f$
+*/
+class LundyMeesCooling{
+public:
+	explicit LundyMeesCooling(double beta):beta(beta){}
+	double next(double temp, const CoolingState& state){
+		return temp/(1 + beta*temp);
+	}
+	double advance(double temp, const CoolingState& state, long iterations){
+		//1/T grows by beta every iteration
+		return temp/(1 + iterations*beta*temp);
+	}
+private:
+	double beta;
+};
+
+/**
+	Geometric cooling that reheats to a fraction of the start temperature when no neighbour was
+	accepted for stallLength iterations in a row, every reheat goes to a lower temperature than
+	the previous one.
+*/
+class ReheatingCooling{
+public:
+	explicit ReheatingCooling(double alpha, long stallLength = 1000, double reheatFraction = 0.5)
+		:alpha(alpha),stallLength(stallLength),reheatFraction(reheatFraction),stalled(0),reheats(0){}
+	double next(double temp, const CoolingState& state){
+		stalled = state.accepted ? 0 : stalled+1;
+		if(stalled >= stallLength){
+			stalled = 0;
+			reheats++;
+			return state.startTemp*pow(reheatFraction, (double)reheats);
+		}
+		return temp*alpha;
+	}
+	double advance(double temp, const CoolingState& state, long iterations){
+		//the rejected iterations reheat every stallLength iterations and cool down in between
+		long cooled = iterations-1;
+		if(stalled + cooled >= stallLength){
+			reheats += (stalled + cooled)/stallLength;
+			stalled = (stalled + cooled)%stallLength;
+			temp = state.startTemp*pow(reheatFraction, (double)reheats);
+			cooled = stalled;
+		}else{
+			stalled += cooled;
+		}
+		return next(temp*pow(alpha, (double)cooled), state);
+	}
+	long getReheats() const{
+		return reheats;
+	}
+private:
+	double alpha;
+	long stallLength;
+	double reheatFraction;
+	long stalled;
+	long reheats;
+};
+
+/**
+	Lam's adaptive schedule (in the form of Boyan's modified Lam schedule): the temperature is
+	raised or lowered by factor to steer the acceptance rate along a target that starts at 1,
+	stays at 0.44 for the middle of the run and goes to 0 at the end.
+*/
+class LamCooling{
+public:
+	explicit LamCooling(double factor, long expectedIterations = 100000)
+		:factor(factor),expectedIterations(expectedIterations),acceptanceRate(0.5){
+		assert(factor > 0 && factor < 1);
+	}
+	double next(double temp, const CoolingState& state){
+		acceptanceRate = 0.998*acceptanceRate + (state.accepted ? 0.002 : 0);
+		return acceptanceRate > targetRate(state.iteration) ? temp*factor : temp/factor;
+	}
+	//the schedule steers by every single iteration, so they are taken one at a time
+	double advance(double temp, const CoolingState& state, long iterations){
+		CoolingState rejected = {state.startTemp, state.iteration-iterations+1, false};
+		for(; rejected.iteration < state.iteration; rejected.iteration++){
+			temp = next(temp, rejected);
+		}
+		return next(temp, state);
+	}
+	double getAcceptanceRate() const{
+		return acceptanceRate;
+	}
+private:
+	double factor;
+	long expectedIterations;
+	double acceptanceRate; // exponential moving average
+
+	double targetRate(long iteration) const{
+		double progress = (double)iteration/expectedIterations;
+		if(progress < 0.15){
+			return 0.44 + 0.56*pow(560.0, -progress/0.15);
+		}else if(progress < 0.65){
+			return 0.44;
+		}else{
+			return 0.44*pow(440.0, -(progress-0.65)/0.35);
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,300 @@
+#ifndef __COOPERATIVE_SCHEDULER_H
+#define __COOPERATIVE_SCHEDULER_H
+
+#include <vector>
+#include <deque>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <assert.h>
+#include "solve_options.h"
+
+
+
+/***********************************************************************************************//**
+
+	\brief Cooperative scheduler for many small searches
+
+	Runs any number of jobs on a fixed number of worker threads. A job is resumed for a slice of
+	at most sliceLength iterations and then gives its thread back, so thousands of small
+	searches share a few threads instead of each paying for a thread of its own.
+
+	The order in which waiting jobs get their next slice is either
+	- ROUND_ROBIN: first come first served, every job gets its turn
+	- DEADLINE_PRIORITY: the job with the earliest deadline first (jobs with equal deadlines
+	  round robin)
+
+	AnnealJob turns a (Static)SimulatedAnnealing object into a job using its resumable
+	solve (beginSolve(), resume() and getResult()).
+
+***************************************************************************************************/
+
+class CooperativeJob{
+
+public:
+
+	CooperativeJob():deadline(std::chrono::steady_clock::time_point::max()){}
+
+	virtual ~CooperativeJob(){}
+
+	/**
+		Continues the job
+			@param maxIterations The maximum number of iterations before the thread is given back
+			@return Whether or not the job needs more slices
+	*/
+	virtual bool resume(long maxIterations) = 0;
+
+	/**
+		Called (from a worker thread) once resume() returned false
+	*/
+	virtual void finish(){}
+
+	std::chrono::steady_clock::time_point deadline; // used by DEADLINE_PRIORITY
+
+};
+
+/**
+	Job that runs solve(options) of an Annealer, a (Static)SimulatedAnnealing child class. The
+	deadline of the options is also the deadline of the job. The annealer is owned (and
+	deleted) by the job.
+*/
+template <class Annealer>
+class AnnealJob:public CooperativeJob{
+
+public:
+
+	typedef typename Annealer::SolutionType Solution;
+
+	AnnealJob(Annealer* annealer, const SolveOptions& options);
+	~AnnealJob();
+
+	bool resume(long maxIterations);
+	void finish();
+
+	/**
+		@return The result of the search, only valid once the job finished
+	*/
+	const SolveResult<Solution>& getResult() const;
+
+	Annealer& getAnnealer();
+
+private:
+	Annealer* annealer;
+	SolveOptions options;
+	bool started;
+	SolveResult<Solution> result;
+
+	AnnealJob(const AnnealJob&);
+	AnnealJob& operator=(const AnnealJob&);
+};
+
+class CooperativeScheduler{
+
+public:
+
+	enum Mode{ ROUND_ROBIN, DEADLINE_PRIORITY };
+
+	/**
+		Constructor
+			@param mode The order in which waiting jobs are resumed
+			@param sliceLength The number of iterations a job runs before it gives its thread back
+			@param nThreads The number of worker threads, 0 uses one thread per hardware thread
+	*/
+	CooperativeScheduler(Mode mode = ROUND_ROBIN, long sliceLength = 256, unsigned nThreads = 0);
+
+	/**
+		Finishes the submitted jobs and joins the workers
+	*/
+	~CooperativeScheduler();
+
+	/**
+		Adds a job, it isn't owned by the scheduler and has to live until it finished
+	*/
+	void submit(CooperativeJob* job);
+
+	/**
+		Blocks until all submitted jobs have finished
+	*/
+	void wait();
+
+	unsigned size() const;
+
+	long getFinished() const;
+
+private:
+	struct Entry{
+		std::chrono::steady_clock::time_point deadline;
+		unsigned long sequence; // keeps jobs with equal deadlines in round robin order
+		CooperativeJob* job;
+
+		//std::priority_queue puts the largest first, so later deadlines are "smaller"
+		bool operator<(const Entry& other) const{
+			if(deadline != other.deadline) return deadline > other.deadline;
+			return sequence > other.sequence;
+		}
+	};
+
+	const Mode MODE;
+	const long SLICE_LENGTH;
+
+	std::vector<std::thread> workers;
+	mutable std::mutex mutex; // guards everything below
+	std::condition_variable jobAvailable;
+	std::condition_variable allDone;
+	std::deque<CooperativeJob*> roundRobin;
+	std::priority_queue<Entry> byDeadline;
+	unsigned long sequence;
+	unsigned active; // jobs submitted but not yet finished
+	long finished;
+	bool stopping;
+
+	void work();
+	void put(CooperativeJob* job); // mutex has to be locked
+	CooperativeJob* take(); // mutex has to be locked, queue may not be empty
+	bool empty() const; // mutex has to be locked
+
+	CooperativeScheduler(const CooperativeScheduler&);
+	CooperativeScheduler& operator=(const CooperativeScheduler&);
+};
+
+template <class Annealer>
+AnnealJob<Annealer>::AnnealJob(Annealer* annealer, const SolveOptions& options):annealer(annealer),options(options),started(false){
+	deadline = options.deadline;
+}
+
+template <class Annealer>
+AnnealJob<Annealer>::~AnnealJob(){
+	delete annealer;
+}
+
+template <class Annealer>
+bool AnnealJob<Annealer>::resume(long maxIterations){
+	if(!started){
+		annealer->beginSolve(options);
+		started = true;
+	}
+	return annealer->resume(maxIterations);
+}
+
+template <class Annealer>
+void AnnealJob<Annealer>::finish(){
+	result = annealer->getResult();
+}
+
+template <class Annealer>
+const SolveResult<typename AnnealJob<Annealer>::Solution>& AnnealJob<Annealer>::getResult() const{
+	return result;
+}
+
+template <class Annealer>
+Annealer& AnnealJob<Annealer>::getAnnealer(){
+	return *annealer;
+}
+
+inline CooperativeScheduler::CooperativeScheduler(Mode mode, long sliceLength, unsigned nThreads)
+		:MODE(mode),SLICE_LENGTH(sliceLength),sequence(0),active(0),finished(0),stopping(false){
+	assert(sliceLength > 0);
+	if(nThreads == 0){
+		nThreads = std::thread::hardware_concurrency();
+		if(nThreads == 0) nThreads = 1;
+	}
+	for(unsigned i=0; i<nThreads; i++){
+		workers.push_back(std::thread(&CooperativeScheduler::work, this));
+	}
+}
+
+inline CooperativeScheduler::~CooperativeScheduler(){
+	wait();
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	jobAvailable.notify_all();
+	for(size_t i=0; i<workers.size(); i++){
+		workers[i].join();
+	}
+}
+
+inline void CooperativeScheduler::submit(CooperativeJob* job){
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		active++;
+		put(job);
+	}
+	jobAvailable.notify_one();
+}
+
+inline void CooperativeScheduler::wait(){
+	std::unique_lock<std::mutex> lock(mutex);
+	while(active > 0){
+		allDone.wait(lock);
+	}
+}
+
+inline unsigned CooperativeScheduler::size() const{
+	return (unsigned)workers.size();
+}
+
+inline long CooperativeScheduler::getFinished() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return finished;
+}
+
+inline void CooperativeScheduler::put(CooperativeJob* job){
+	if(MODE == ROUND_ROBIN){
+		roundRobin.push_back(job);
+	}else{
+		Entry entry = {job->deadline, sequence++, job};
+		byDeadline.push(entry);
+	}
+}
+
+inline CooperativeJob* CooperativeScheduler::take(){
+	CooperativeJob* job;
+	if(MODE == ROUND_ROBIN){
+		job = roundRobin.front();
+		roundRobin.pop_front();
+	}else{
+		job = byDeadline.top().job;
+		byDeadline.pop();
+	}
+	return job;
+}
+
+inline bool CooperativeScheduler::empty() const{
+	return MODE == ROUND_ROBIN ? roundRobin.empty() : byDeadline.empty();
+}
+
+inline void CooperativeScheduler::work(){
+	std::unique_lock<std::mutex> lock(mutex);
+	while(true){
+		while(empty() && !stopping){
+			jobAvailable.wait(lock);
+		}
+		if(empty()){ // stopping and nothing left to do
+			return;
+		}
+		CooperativeJob* job = take();
+		lock.unlock();
+
+		bool more = job->resume(SLICE_LENGTH);
+		if(!more){
+			job->finish();
+		}
+
+		lock.lock();
+		if(more){
+			put(job);
+		}else{
+			finished++;
+			active--;
+			if(active == 0){
+				allDone.notify_all();
+			}
+		}
+	}
+}
+
+#endif
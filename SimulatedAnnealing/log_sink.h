@@ -0,0 +1,231 @@
+#ifndef __LOG_SINK_H
+#define __LOG_SINK_H
+
+#include <iostream>	// needed for basic IO
+#include <string>
+#include <cstring>	// needed for memcpy
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <assert.h>
+
+
+
+/***********************************************************************************************//**
+
+	\brief Log sinks for the status output of the Simulated Annealing Framework
+
+	printStatus() and the messages of solve() don't write to std::cout themselves, they hand
+	their lines to a LogSink. The standard sink (consoleLogSink()) is an AsyncLogSink: the
+	search loop only copies the line into a lock-free ring buffer, a background thread writes
+	it to the terminal. When the buffer is full lines are dropped (and counted) rather than
+	making the search wait. NullLogSink throws everything away, e.g. for benchmarks.
+
+	How often printStatus() is called at all is set with setStatusInterval() (see
+	StatusSampler).
+
+***************************************************************************************************/
+
+class LogSink{
+public:
+	virtual ~LogSink(){}
+
+	/**
+		Hands a line over to the sink, may not block on I/O
+			@param line The line without its end of line
+	*/
+	virtual void write(const std::string& line) = 0;
+
+	/**
+		Blocks until everything written so far has been output
+	*/
+	virtual void flush(){}
+};
+
+class NullLogSink:public LogSink{
+public:
+	void write(const std::string& line){}
+};
+
+/**
+	Lock-free bounded ring buffer (Vyukov's sequence number scheme) drained by one background
+	thread. Any number of threads may write to it, each line is one slot, lines longer than
+	LINE_LENGTH are cut off.
+*/
+class AsyncLogSink:public LogSink{
+
+public:
+
+	/**
+		Constructor
+			@param output The stream the background thread writes to
+	*/
+	explicit AsyncLogSink(std::ostream& output);
+
+	/**
+		Writes the remaining lines and stops the background thread
+	*/
+	~AsyncLogSink();
+
+	void write(const std::string& line);
+	void flush();
+
+	//number of lines dropped because the buffer was full
+	unsigned long getDropped() const;
+
+private:
+	static const size_t CAPACITY = 1024; // power of 2
+	static const size_t LINE_LENGTH = 240;
+
+	struct Slot{
+		std::atomic<size_t> sequence; // == position: free to write, == position+1: ready to read
+		size_t length;
+		char line[LINE_LENGTH];
+	};
+
+	std::ostream& output;
+	Slot slots[CAPACITY];
+	std::atomic<size_t> writePosition;
+	size_t readPosition; // only used by the background thread
+	std::atomic<size_t> done; // number of slots written to output
+	std::atomic<unsigned long> dropped;
+	std::atomic<bool> stopping;
+	std::thread worker;
+
+	bool drain();
+	void work();
+
+	AsyncLogSink(const AsyncLogSink&);
+	AsyncLogSink& operator=(const AsyncLogSink&);
+};
+
+/**
+	@return The sink used by every SimulatedAnnealing object that wasn't given another one, an
+			AsyncLogSink writing to std::cout
+*/
+inline LogSink& consoleLogSink(){
+	static AsyncLogSink sink(std::cout);
+	return sink;
+}
+
+/**
+	Decides in which iterations the status is printed: every N iterations and/or every T
+	milliseconds (0 disables either), the clock is only read every CLOCK_CHECK iterations so the
+	check stays cheap in the search loop.
+*/
+class StatusSampler{
+
+public:
+
+	StatusSampler(long everyIterations = 0, double everyMilliseconds = 100);
+
+	bool shouldSample(long iteration);
+
+private:
+	static const long CLOCK_CHECK = 256;
+
+	long everyIterations;
+	std::chrono::steady_clock::duration interval;
+	std::chrono::steady_clock::time_point next;
+	bool timed;
+};
+
+inline AsyncLogSink::AsyncLogSink(std::ostream& output):output(output),writePosition(0),readPosition(0),done(0),dropped(0),stopping(false){
+	for(size_t i=0; i<CAPACITY; i++){
+		slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	worker = std::thread(&AsyncLogSink::work, this);
+}
+
+inline AsyncLogSink::~AsyncLogSink(){
+	stopping = true;
+	worker.join();
+}
+
+inline void AsyncLogSink::write(const std::string& line){
+	size_t position = writePosition.load(std::memory_order_relaxed);
+	Slot* slot;
+	while(true){
+		slot = &slots[position & (CAPACITY-1)];
+		size_t sequence = slot->sequence.load(std::memory_order_acquire);
+		if(sequence == position){
+			if(writePosition.compare_exchange_weak(position, position+1, std::memory_order_relaxed)){
+				break;
+			}
+		}else if(sequence < position){ // full, the background thread hasn't read this slot yet
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}else{
+			position = writePosition.load(std::memory_order_relaxed);
+		}
+	}
+	slot->length = line.size() < LINE_LENGTH ? line.size() : LINE_LENGTH;
+	memcpy(slot->line, line.data(), slot->length);
+	slot->sequence.store(position+1, std::memory_order_release);
+}
+
+inline void AsyncLogSink::flush(){
+	size_t target = writePosition.load();
+	while(done.load() < target){
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+inline unsigned long AsyncLogSink::getDropped() const{
+	return dropped.load();
+}
+
+//writes all lines that are ready, returns whether there were any
+inline bool AsyncLogSink::drain(){
+	bool any = false;
+	while(true){
+		Slot& slot = slots[readPosition & (CAPACITY-1)];
+		if(slot.sequence.load(std::memory_order_acquire) != readPosition+1){
+			break;
+		}
+		output.write(slot.line, slot.length);
+		output.put('\n');
+		slot.sequence.store(readPosition+CAPACITY, std::memory_order_release);
+		readPosition++;
+		any = true;
+	}
+	if(any){
+		output.flush();
+		done.store(readPosition);
+	}
+	return any;
+}
+
+inline void AsyncLogSink::work(){
+	while(true){
+		bool stop = stopping.load();
+		if(!drain()){
+			if(stop){
+				return;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+}
+
+inline StatusSampler::StatusSampler(long everyIterations, double everyMilliseconds):everyIterations(everyIterations)
+		,interval(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(everyMilliseconds)))
+		,next(std::chrono::steady_clock::now()),timed(everyMilliseconds > 0){
+	assert(everyIterations >= 0);
+}
+
+inline bool StatusSampler::shouldSample(long iteration){
+	if(everyIterations > 0 && iteration % everyIterations == 0){
+		return true;
+	}
+	if(timed && iteration % CLOCK_CHECK == 0){
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if(now >= next){
+			next = now + interval;
+			return true;
+		}
+	}
+	return false;
+}
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef __MULTI_START_H
+#define __MULTI_START_H
+
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <assert.h>
+#include "simulated_annealing.h"
+#include "thread_pool.h"
+
+
+
+/***********************************************************************************************//**
+
+	\brief Multi-start driver for the Simulated Annealing Framework
+
+	Runs many independent chains (objects of a SimulatedAnnealing child class), each with its own
+	seed and start solution as created by a factory, on a work-stealing ThreadPool sized to the
+	machine. The chains run in slices of a fixed number of iterations so more chains than
+	threads still all make progress.
+
+	Every slice is a call of the anytime solve(options) of the chain, so the best solution of a
+	chain is kept even when the chain moves away from it again. The best distance found so far is
+	published through a lock-free atomic. All chains stop as soon as one of them is within the
+	required precision of the target or the deadline passes.
+
+***************************************************************************************************/
+
+template <class Solution, class Target, class RNG = Xoshiro256, 
+			class Cooling = GeometricCooling, class Acceptance = MetropolisAcceptance>
+class MultiStart{
+
+public:
+
+	typedef SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance> Chain;
+
+	/**
+		Creates chain number index using the given seed, it is called from the worker threads so
+		it has to be thread safe. The returned chain is owned (and deleted) by MultiStart.
+	*/
+	typedef std::function<Chain*(int index, uint64_t seed)> ChainFactory;
+
+	/**
+		Constructor
+			@param factory The factory used to create the chains
+			@param nChains The number of chains
+			@param seed The seed from which the seeds of the chains are derived
+			@param nThreads The number of worker threads, 0 uses one thread per hardware thread
+			@param sliceLength The number of iterations a chain does before it gives other chains
+								the chance to run
+	*/
+	MultiStart(const ChainFactory& factory, int nChains, uint64_t seed = 0, unsigned nThreads = 0, int sliceLength = 1000);
+
+	~MultiStart();
+
+	/**
+		Runs all chains until one of them is within the required precision, the deadline passes
+		or every chain did maxIterations iterations.
+			@param maxSeconds The wall clock time after which all chains are stopped
+			@param maxIterations The maximum number of iterations per chain, negative for no limit
+			@return Whether or not a chain reached the required precision
+	*/
+	bool run(double maxSeconds, long maxIterations = -1);
+
+	double getBestDistance() const;
+
+	/**
+		@return A copy of the best solution found by any chain, 0 if run() wasn't called yet
+	*/
+	const Solution* getBestSolution() const;
+
+	int getBestChain() const;
+
+	long getIterations(int index) const;
+
+private:
+	const ChainFactory factory;
+	const int N_CHAINS;
+	const uint64_t SEED;
+	const int SLICE_LENGTH;
+
+	std::vector<Chain*> chains;
+	std::vector<long> iterations;
+	std::chrono::steady_clock::time_point deadline;
+	long maxIterations;
+
+	std::atomic<double> bestDistance;
+	std::atomic<bool> stop;
+	std::atomic<bool> solved;
+
+	std::mutex bestMutex; // guards the best solution
+	std::shared_ptr<const Solution> bestSolution;
+	double bestSolutionDistance;
+	int bestChain;
+
+	ThreadPool pool; // last member, so its workers are joined before the rest is destroyed
+
+	void runSlice(int index);
+	void publish(int index, const SolveResult<Solution>& result);
+
+	MultiStart(const MultiStart&);
+	MultiStart& operator=(const MultiStart&);
+};
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+MultiStart<Solution,Target,RNG,Cooling,Acceptance>::MultiStart(const ChainFactory& factory, int nChains, uint64_t seed, unsigned nThreads, int sliceLength)
+		:factory(factory),N_CHAINS(nChains),SEED(seed),SLICE_LENGTH(sliceLength),chains(nChains, (Chain*)0),iterations(nChains, 0)
+		,maxIterations(-1),bestDistance(HUGE_VAL),stop(false),solved(false),bestSolutionDistance(HUGE_VAL)
+		,bestChain(-1),pool(nThreads){
+	assert(nChains > 0);
+	assert(sliceLength > 0);
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+MultiStart<Solution,Target,RNG,Cooling,Acceptance>::~MultiStart(){
+	pool.wait();
+	for(int i=0; i<N_CHAINS; i++){
+		delete chains[i];
+	}
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+bool MultiStart<Solution,Target,RNG,Cooling,Acceptance>::run(double maxSeconds, long maxIterations){
+	deadline = std::chrono::steady_clock::now() + std::chrono::microseconds((long long)(maxSeconds*1e6));
+	this->maxIterations = maxIterations;
+	stop = false;
+
+	for(int i=0; i<N_CHAINS; i++){
+		pool.submit([this, i](){ runSlice(i); });
+	}
+	pool.wait();
+
+	return solved;
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+void MultiStart<Solution,Target,RNG,Cooling,Acceptance>::runSlice(int index){
+	if(stop.load(std::memory_order_relaxed)){
+		return;
+	}
+
+	Chain* chain = chains[index];
+	if(chain == 0){
+		chain = chains[index] = factory(index, SEED+index);
+	}
+
+	SolveOptions options;
+	options.deadline = deadline;
+	options.cancel = &stop;
+	options.maxIterations = SLICE_LENGTH;
+	if(maxIterations >= 0 && maxIterations-iterations[index] < SLICE_LENGTH){
+		options.maxIterations = maxIterations-iterations[index];
+	}
+	SolveResult<Solution> result = chain->solve(options);
+	iterations[index] += result.iterations;
+	publish(index, result);
+
+	if(result.stopReason == STOP_PRECISION){
+		solved = true;
+		stop = true;
+	}else if(result.stopReason == STOP_DEADLINE){
+		stop = true;
+	}else if(result.stopReason == STOP_ITERATIONS && (maxIterations < 0 || iterations[index] < maxIterations)){
+		pool.submit([this, index](){ runSlice(index); });
+	}
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+void MultiStart<Solution,Target,RNG,Cooling,Acceptance>::publish(int index, const SolveResult<Solution>& result){
+	double distance = result.bestDistance;
+	double current = bestDistance.load();
+	while(distance < current){
+		if(bestDistance.compare_exchange_weak(current, distance)){
+			// new overall best, only now the lock is taken
+			std::lock_guard<std::mutex> lock(bestMutex);
+			if(distance < bestSolutionDistance){
+				bestSolution = result.bestSolution;
+				bestSolutionDistance = distance;
+				bestChain = index;
+			}
+			return;
+		}
+	}
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+double MultiStart<Solution,Target,RNG,Cooling,Acceptance>::getBestDistance() const{
+	return bestDistance.load();
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+const Solution* MultiStart<Solution,Target,RNG,Cooling,Acceptance>::getBestSolution() const{
+	return bestSolution.get();
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+int MultiStart<Solution,Target,RNG,Cooling,Acceptance>::getBestChain() const{
+	return bestChain;
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+long MultiStart<Solution,Target,RNG,Cooling,Acceptance>::getIterations(int index) const{
+	return iterations[index];
+}
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef __PARALLEL_TEMPERING_H
+#define __PARALLEL_TEMPERING_H
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <assert.h>
+#include "simulated_annealing.h"
+#include "thread_pool.h"
+
+
+
+/***********************************************************************************************//**
+
+	\brief Parallel Tempering (replica exchange) driver for the Simulated Annealing Framework
+
+	R replicas of a problem (objects of a SimulatedAnnealing child class, e.g.
+	SimulatedAnnealingNQueens) each search at their own, fixed temperature of a ladder.
+	The replicas do their steps in parallel on a ThreadPool, after every round neighbouring
+	replicas try to exchange their solutions using the Metropolis criterion
+
+	\f$
+		P_{swap}(i,i+1) = min(1, exp((\frac{1}{T_i}-\frac{1}{T_{i+1}})(f(s_i)-f(s_{i+1}))))
+	\f$
+
+	The replicas are used through their own giveRandomNeighbour()/calcDistanceToTarget()
+	(or move interface) overrides, nothing problem specific has to be written for this driver.
+	The replicas are not owned by this object.
+
+***************************************************************************************************/
+
+template <class Solution, class Target, class RNG = Xoshiro256, 
+			class Cooling = GeometricCooling, class Acceptance = MetropolisAcceptance>
+class ParallelTempering{
+
+public:
+
+	typedef SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance> Replica;
+
+	/**
+		Constructor
+			@param replicas The replicas, replica i will search at temperature temps[i]
+			@param temps The temperature ladder, sorted from low to high
+			@param sweepLength The number of steps every replica does between two exchange rounds
+			@param nThreads The number of worker threads, 0 uses one thread per hardware thread
+			@param seed The seed of the random number engine used for the exchanges
+	*/
+	ParallelTempering(const std::vector<Replica*>& replicas, const std::vector<double>& temps,
+						int sweepLength, unsigned nThreads = 0, uint64_t seed = 0);
+
+	/**
+		Runs exchange rounds until one of the replicas is within the required precision or
+		maxRounds rounds have been done.
+			@param maxRounds The maximum number of rounds
+			@return Whether or not a replica reached the required precision
+	*/
+	bool run(long maxRounds);
+
+	/**
+		@return The replica that currently has the lowest distance to the target
+	*/
+	Replica* getBestReplica() const;
+
+	/**
+		@param pair The index i of the pair of replicas (i, i+1)
+		@return The fraction of the attempted exchanges of this pair that was accepted
+	*/
+	double getSwapAcceptanceRate(int pair) const;
+
+	void printSwapAcceptanceRates(std::ostream& output) const;
+
+	/**
+		Creates a geometric ladder of temperatures between tmin and tmax
+			@param tmin The lowest temperature
+			@param tmax The highest temperature
+			@param n The number of temperatures (at least 2)
+	*/
+	static std::vector<double> geometricLadder(double tmin, double tmax, int n);
+
+private:
+	std::vector<Replica*> replicas;
+	std::vector<long> swapAttempts;
+	std::vector<long> swapAccepts;
+	const int SWEEP_LENGTH;
+	ThreadPool pool;
+	RNG rng;
+	long round;
+
+	void sweep(Replica* replica);
+	void exchange();
+};
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+ParallelTempering<Solution,Target,RNG,Cooling,Acceptance>::ParallelTempering(const std::vector<Replica*>& replicas, const std::vector<double>& temps,
+		int sweepLength, unsigned nThreads, uint64_t seed):replicas(replicas),swapAttempts(replicas.size(), 0),swapAccepts(replicas.size(), 0)
+		,SWEEP_LENGTH(sweepLength),pool(nThreads),rng(seed),round(0){
+	assert(replicas.size() == temps.size());
+	assert(sweepLength > 0);
+	for(size_t i=0; i<replicas.size(); i++){
+		this->replicas[i]->setTemp(temps[i]);
+		this->replicas[i]->evaluateSolution();
+	}
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+bool ParallelTempering<Solution,Target,RNG,Cooling,Acceptance>::run(long maxRounds){
+	for(long r=0; r<maxRounds; r++){
+		for(size_t i=0; i<replicas.size(); i++){
+			Replica* replica = replicas[i];
+			pool.submit([this, replica](){ sweep(replica); });
+		}
+		pool.wait();
+
+		for(size_t i=0; i<replicas.size(); i++){
+			if(replicas[i]->reachedPrecision()){
+				return true;
+			}
+		}
+		exchange();
+	}
+	return false;
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+void ParallelTempering<Solution,Target,RNG,Cooling,Acceptance>::sweep(Replica* replica){
+	for(int i=0; i<SWEEP_LENGTH && !replica->reachedPrecision(); i++){
+		replica->step();
+	}
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+void ParallelTempering<Solution,Target,RNG,Cooling,Acceptance>::exchange(){
+	// even and odd pairs alternate so every pair gets its chance
+	for(size_t i=(size_t)(round%2); i+1<replicas.size(); i+=2){
+		Replica* cold = replicas[i];
+		Replica* hot = replicas[i+1];
+		double exponent = (1.0/cold->getTemp() - 1.0/hot->getTemp())*(cold->getDistance() - hot->getDistance());
+		swapAttempts[i]++;
+		if(exponent >= 0 || rng.nextDouble() < exp(exponent)){
+			cold->swapSolution(*hot);
+			swapAccepts[i]++;
+		}
+	}
+	round++;
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+typename ParallelTempering<Solution,Target,RNG,Cooling,Acceptance>::Replica* ParallelTempering<Solution,Target,RNG,Cooling,Acceptance>::getBestReplica() const{
+	Replica* best = replicas[0];
+	for(size_t i=1; i<replicas.size(); i++){
+		if(replicas[i]->getDistance() < best->getDistance()){
+			best = replicas[i];
+		}
+	}
+	return best;
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+double ParallelTempering<Solution,Target,RNG,Cooling,Acceptance>::getSwapAcceptanceRate(int pair) const{
+	if(swapAttempts[pair] == 0){
+		return 0;
+	}
+	return (double)swapAccepts[pair]/swapAttempts[pair];
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+void ParallelTempering<Solution,Target,RNG,Cooling,Acceptance>::printSwapAcceptanceRates(std::ostream& output) const{
+	for(size_t i=0; i+1<replicas.size(); i++){
+		output << "Pair " << i << "-" << i+1 << " (T=" << replicas[i]->getTemp() << " <-> T=" << replicas[i+1]->getTemp()
+			<< "): " << swapAccepts[i] << "/" << swapAttempts[i] << " = " << getSwapAcceptanceRate((int)i) << std::endl;
+	}
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance>
+std::vector<double> ParallelTempering<Solution,Target,RNG,Cooling,Acceptance>::geometricLadder(double tmin, double tmax, int n){
+	assert(n >= 2 && tmin > 0 && tmax >= tmin);
+	std::vector<double> temps(n);
+	double factor = pow(tmax/tmin, 1.0/(n-1));
+	temps[0] = tmin;
+	for(int i=1; i<n; i++){
+		temps[i] = temps[i-1]*factor;
+	}
+	return temps;
+}
+
+#endif
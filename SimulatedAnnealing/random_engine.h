@@ -0,0 +1,250 @@
+#ifndef __RANDOM_ENGINE_H
+#define __RANDOM_ENGINE_H
+
+#include <stdint.h>	// needed for fixed size integers
+#include <cmath>	// needed for log
+#include <cstring>	// needed for memcpy
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>	// needed for the vectorised BatchXoshiro256
+#endif
+
+
+
+/***********************************************************************************************//**
+
+	\brief Random number engine used by the Simulated Annealing Framework
+
+	xoshiro256** generator (Blackman & Vigna). It is small (4 words of state), fast and of
+	good statistical quality. Every SimulatedAnnealing object owns one, so chains never share
+	state and can be reproduced from their seed.
+
+	Any class can be used as RNG template parameter of SimulatedAnnealing as long as it offers:
+	- a constructor taking a uint64_t seed
+	- seed(uint64_t)
+	- next(): a uniformly distributed 64 bit value
+	- nextDouble(): a uniformly distributed value in [0,1)
+	- nextInt(n): a uniformly distributed value in [0,n)
+
+***************************************************************************************************/
+
+class Xoshiro256{
+
+public:
+
+	/**
+		Constructor
+			@param seed The seed from which the state is generated, equal seeds give equal streams
+	*/
+	explicit Xoshiro256(uint64_t seed = 0){
+		this->seed(seed);
+	}
+
+	/**
+		Resets the state, the 4 state words are filled using splitmix64 so that any seed
+		(including 0) gives a valid state
+			@param seed The new seed
+	*/
+	void seed(uint64_t seed){
+		for(int i=0; i<4; i++){
+			seed += 0x9E3779B97F4A7C15ULL;
+			uint64_t z = seed;
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+			s[i] = z ^ (z >> 31);
+		}
+	}
+
+	uint64_t next(){
+		const uint64_t result = rotl(s[1] * 5, 7) * 9;
+		const uint64_t t = s[1] << 17;
+
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+
+		s[2] ^= t;
+		s[3] = rotl(s[3], 45);
+
+		return result;
+	}
+
+	/**
+		@return A double in [0,1) using the upper 53 bits of next()
+	*/
+	double nextDouble(){
+		return (next() >> 11) * (1.0/9007199254740992.0);
+	}
+
+	/**
+		Multiply-shift reduction, avoids the integer division of rand()%n
+			@param n The (positive) number of possible values
+			@return An int in [0,n)
+	*/
+	int nextInt(int n){
+		return (int)(((next() >> 32) * (uint64_t)n) >> 32);
+	}
+
+	/**
+		@return The 4 state words, e.g. to start the lanes of a BatchXoshiro256
+	*/
+	const uint64_t* getState() const{
+		return s;
+	}
+
+private:
+	uint64_t s[4];
+
+	static uint64_t rotl(uint64_t x, int k){
+		return (x << k) | (x >> (64 - k));
+	}
+
+};
+
+/**
+	LANES independent xoshiro256** streams stored as structure of arrays, so one call of next() 
+	advances all of them with AVX-512 (8 lanes per instruction) or AVX2 (4 lanes) when the 
+	compiler targets it and with a plain loop otherwise. Lane i gives the same stream as 
+	Xoshiro256(seed+i) on every path. Used by BatchedSimulatedAnnealing.
+*/
+template <int LANES>
+class BatchXoshiro256{
+
+public:
+
+	explicit BatchXoshiro256(uint64_t seed = 0){
+		for(int i=0; i<LANES; i++){
+			Xoshiro256 lane(seed+i);
+			for(int j=0; j<4; j++){
+				s[j][i] = lane.getState()[j];
+			}
+		}
+	}
+
+	/**
+		Fills out with the next value of every lane
+	*/
+	void next(uint64_t* out){
+		int i = 0;
+#if defined(__AVX512F__)
+		for(; i+8<=LANES; i+=8){
+			__m512i s0 = _mm512_loadu_si512((const void*)&s[0][i]);
+			__m512i s1 = _mm512_loadu_si512((const void*)&s[1][i]);
+			__m512i s2 = _mm512_loadu_si512((const void*)&s[2][i]);
+			__m512i s3 = _mm512_loadu_si512((const void*)&s[3][i]);
+
+			__m512i times5 = _mm512_add_epi64(s1, _mm512_slli_epi64(s1, 2));
+			__m512i rotated = _mm512_rol_epi64(times5, 7);
+			__m512i result = _mm512_add_epi64(rotated, _mm512_slli_epi64(rotated, 3));
+			__m512i t = _mm512_slli_epi64(s1, 17);
+
+			s2 = _mm512_xor_si512(s2, s0);
+			s3 = _mm512_xor_si512(s3, s1);
+			s1 = _mm512_xor_si512(s1, s2);
+			s0 = _mm512_xor_si512(s0, s3);
+			s2 = _mm512_xor_si512(s2, t);
+			s3 = _mm512_rol_epi64(s3, 45);
+
+			_mm512_storeu_si512((void*)&s[0][i], s0);
+			_mm512_storeu_si512((void*)&s[1][i], s1);
+			_mm512_storeu_si512((void*)&s[2][i], s2);
+			_mm512_storeu_si512((void*)&s[3][i], s3);
+			_mm512_storeu_si512((void*)&out[i], result);
+		}
+#endif
+#if defined(__AVX2__)
+		for(; i+4<=LANES; i+=4){
+			__m256i s0 = _mm256_loadu_si256((const __m256i*)&s[0][i]);
+			__m256i s1 = _mm256_loadu_si256((const __m256i*)&s[1][i]);
+			__m256i s2 = _mm256_loadu_si256((const __m256i*)&s[2][i]);
+			__m256i s3 = _mm256_loadu_si256((const __m256i*)&s[3][i]);
+
+			__m256i times5 = _mm256_add_epi64(s1, _mm256_slli_epi64(s1, 2));
+			__m256i rotated = _mm256_or_si256(_mm256_slli_epi64(times5, 7), _mm256_srli_epi64(times5, 57));
+			__m256i result = _mm256_add_epi64(rotated, _mm256_slli_epi64(rotated, 3));
+			__m256i t = _mm256_slli_epi64(s1, 17);
+
+			s2 = _mm256_xor_si256(s2, s0);
+			s3 = _mm256_xor_si256(s3, s1);
+			s1 = _mm256_xor_si256(s1, s2);
+			s0 = _mm256_xor_si256(s0, s3);
+			s2 = _mm256_xor_si256(s2, t);
+			s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+
+			_mm256_storeu_si256((__m256i*)&s[0][i], s0);
+			_mm256_storeu_si256((__m256i*)&s[1][i], s1);
+			_mm256_storeu_si256((__m256i*)&s[2][i], s2);
+			_mm256_storeu_si256((__m256i*)&s[3][i], s3);
+			_mm256_storeu_si256((__m256i*)&out[i], result);
+		}
+#endif
+		for(; i<LANES; i++){
+			const uint64_t result = rotl(s[1][i] * 5, 7) * 9;
+			const uint64_t t = s[1][i] << 17;
+
+			s[2][i] ^= s[0][i];
+			s[3][i] ^= s[1][i];
+			s[1][i] ^= s[2][i];
+			s[0][i] ^= s[3][i];
+
+			s[2][i] ^= t;
+			s[3][i] = rotl(s[3][i], 45);
+
+			out[i] = result;
+		}
+	}
+
+	/**
+		Turns values of next() into doubles in [0,1), using the upper 52 bits as mantissa of a 
+		double in [1,2) avoids the 64 bit integer conversion AVX2 doesn't have
+	*/
+	static void toDouble(const uint64_t* bits, double* out){
+		for(int i=0; i<LANES; i++){
+			uint64_t mantissa = (bits[i] >> 12) | 0x3FF0000000000000ULL;
+			double value;
+			memcpy(&value, &mantissa, sizeof(double));
+			out[i] = value - 1.0;
+		}
+	}
+
+private:
+	alignas(64) uint64_t s[4][LANES];
+
+	static uint64_t rotl(uint64_t x, int k){
+		return (x << k) | (x >> (64 - k));
+	}
+
+};
+
+/**
+	Buffer of exponentially distributed values \f$ -ln(u) \f$ with u uniform in (0,1]. The values 
+	are drawn in batches so the logarithms are computed in one tight (vectorisable) loop instead of 
+	one at a time in the search loop. Used by the max change acceptance test of SimulatedAnnealing.
+*/
+class ExponentialDraws{
+
+public:
+
+	ExponentialDraws():used(SIZE){}
+
+	template <class RNG> double next(RNG& rng){
+		if(used == SIZE){
+			for(int i=0; i<SIZE; i++){
+				values[i] = 1.0 - rng.nextDouble();
+			}
+			for(int i=0; i<SIZE; i++){
+				values[i] = -log(values[i]);
+			}
+			used = 0;
+		}
+		return values[used++];
+	}
+
+private:
+	static const int SIZE = 64;
+	double values[SIZE];
+	int used;
+
+};
+
+#endif
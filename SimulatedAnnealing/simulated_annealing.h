@@ -4,6 +4,7 @@
 #include <iostream>	// needed for basic IO
 #include <cmath>	// needed for chance calculation
 #include <assert.h> // will use assert to check certain values
+#include "static_simulated_annealing.h"	// the search loop itself
 
 
 
@@ -28,6 +29,34 @@
 	- calcProbability()
 	- calcNewTemp()
 
+	Optional move interface (see getNeighbourMode()):
+	- proposeMove()
+	- calcMoveChange()
+	- commitMove()
+	- discardMove()
+
+	Optional in-place interface (see getNeighbourMode()):
+	- applyRandomMove()
+	- undoMove()
+
+	Optional max change acceptance (see useMaxChangeAcceptance()):
+	- calcMaxChange()
+	- calcDistanceToTargetBounded() or calcMoveChangeBounded()
+
+	Optional rejection-free steps (see useRejectionFreeSteps()):
+	- proposeRejectionFreeMove()
+
+	Optional checkpoint state (see saveCheckpoint()):
+	- writeProblemState()
+	- readProblemState()
+
+	The distance of the current solution to the target is cached, so every iteration only 
+	evaluates the candidate (or, with the move interface, only the change a move causes).
+
+	The search loop itself is implemented by StaticSimulatedAnnealing (which resolves the hooks at 
+	compile time), this class only turns the hooks into virtual functions. Problems whose hooks 
+	are cheap enough for the virtual calls to matter can use StaticSimulatedAnnealing directly.
+
 
 
 	The type of the candidate solutions can be set using template parameters.
@@ -35,10 +64,28 @@
 	The link between these two types is made by the calcDistanceToTarget function which is one of 
 	the functions that require overriding.
 
+	The random number engine can be set using the third template parameter (see random_engine.h), 
+	every object owns its own engine (rng) which child classes should use for all their random 
+	decisions, that way a run can be reproduced from its seed.
+
+	The standard calcNewTemp() and calcProbability() use the cooling schedule and acceptance rule 
+	given as template parameters (see cooling_schedules.h and acceptance_rules.h), so trying 
+	another schedule or rule doesn't require a child class of its own.
+
+	The solutions the framework keeps and throws away go through the solution allocator given as 
+	last template parameter (see solution_allocators.h), with SolutionPool rejected candidates 
+	are recycled instead of deleted. giveRandomNeighbour() should then make its candidate with 
+	copySolution().
+
 ***************************************************************************************************/
 
-template <class Solution, class Target>
-class SimulatedAnnealing{
+template <class Solution, class Target, class RNG = Xoshiro256, 
+			class Cooling = GeometricCooling, class Acceptance = MetropolisAcceptance, 
+			class Allocator = HeapSolutionAllocator<Solution> >
+class SimulatedAnnealing:public StaticSimulatedAnnealing<SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>, Solution, Target, RNG, Cooling, Acceptance, Allocator>{
+
+	typedef StaticSimulatedAnnealing<SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>, Solution, Target, RNG, Cooling, Acceptance, Allocator> Base;
+	friend class StaticSimulatedAnnealing<SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>, Solution, Target, RNG, Cooling, Acceptance, Allocator>;
 
 public:	
 	
@@ -49,13 +96,19 @@ public:
 			@param starttemp The starttemperature, the higher this temperature, the longer the 
 								algorythm will allow uphill moves
 			@param PRECISION The required PRECISION for a solution to be acceptable
+			@param alpha The main parameter of the cooling schedule (the factor by which the 
+								standard GeometricCooling lowers the temperature)
+			@param seed The seed of the random number engine of this object
 	*/
-	SimulatedAnnealing(const Solution& startSolution, const Target& target, double starttemp, double precision, double alpha);
-	
+	SimulatedAnnealing(const Solution& startSolution, const Target& target, double starttemp, double precision, double alpha, uint64_t seed = 0);
+
 	/**
-		The public method that is called from a SimulatedAnnealing(or child class)-Object
+		Destructor, deletes the current solution and TARGET if solve() didn't already do so 
+		(and the best solution when it was kept)
 	*/
-	void solve();
+	virtual ~SimulatedAnnealing();
+
+	typedef typename Base::NeighbourMode NeighbourMode;
 
 protected:
 
@@ -70,7 +123,8 @@ protected:
 		up to the user (and can influence the result of the algorythm a lot)
 			@param lastSolution The previous solution which can optionally (and should) be used to 
 									determine the new neighbour
-			@return A pointer to the newly chosen neighbour (you don't have to worry about deleting)
+			@return A pointer to the newly chosen neighbour (you don't have to worry about deleting), 
+						preferably made with copySolution() so it can be recycled
 	*/
 	virtual Solution* giveRandomNeighbour(const Solution& lastSolution)const =0;
 
@@ -102,7 +156,9 @@ protected:
 	virtual bool shouldStopHook(const Solution& solution);
 	
 	/**
-		This function can be used to print some info during execution of the algorythm.
+		This function can be used to print some info during execution of the algorythm. It is 
+		called by solve() as often as set with setStatusInterval(), the lines should be handed to 
+		writeLog() rather than written to std::cout, so the search doesn't wait for the terminal.
 			@param solution The solution that was last considered
 			@param temp The current temperature
 	*/	
@@ -116,7 +172,7 @@ protected:
 		CAUTION: The probability value returned will be checked, probabilities adhere to the following 
 					rule \f$ 0<=probability<=1 \f$
 
-		Standard implementation:
+		Standard implementation asks the Acceptance rule, for the standard MetropolisAcceptance:
 		\f$
 			P(\Delta(f(s)), T) = exp(\frac{\Delta(f(s))}{T})
 		\f$
@@ -129,143 +185,303 @@ protected:
 	/**
 		This function calculates the new temperature based on the previous temperature.
 		
+		Standard implementation asks the Cooling schedule, after a rejection-free step it 
+		advances the schedule by all the iterations the step stood for.
+
 		CAUTION: The temperature value returned will be checked, it has to be a positive value.
 			@param lastTemp The previous temperature which now needs to be updated
 			@return The newly calculated temperature
 	*/
 	virtual double calcNewTemp(double lastTemp) const;
 
+	/**
+		This function determines how new candidates are generated, see NeighbourMode.
+		Problems returning MOVE_NEIGHBOUR have to override the move interface below, problems 
+		returning IN_PLACE_NEIGHBOUR the in-place interface.
 
+		Standard implementation returns COPY_NEIGHBOUR.
+			@return The neighbour mode used by solve()
+	*/
+	virtual NeighbourMode getNeighbourMode() const;
 
 	/***********************************************************************************************
 	 
-		Following functions are standard and SHOULD NOT be overridden
+		Following functions make up the move interface, they only need to be overridden when 
+		getNeighbourMode() returns MOVE_NEIGHBOUR
 	 
 	***********************************************************************************************/
-	
-	bool shouldStop(const Solution& solution);
 
-	double calcDistanceChange(const Solution& oldSolution, const Solution& newSolution) const;
+	/**
+		This function chooses a random move starting from the given solution. The move should be 
+		remembered by the problem but not yet applied to the solution.
+			@param solution The current solution
+	*/
+	virtual void proposeMove(const Solution& solution);
 
-	bool accept(const Solution& oldSolution, const Solution& newSolution, double temp) const;
+	/**
+		This function calculates the change in distance to the target the proposed move would cause.
+			@param solution The current solution
+			@param distance The (cached) distance of the current solution to the target
+			@return The change in distance, negative values are improvements
+	*/
+	virtual double calcMoveChange(const Solution& solution, double distance);
 
-	const Target* TARGET;
-	const double PRECISION;
-	const double ALPHA;
+	/**
+		This function applies the proposed move to the solution.
+			@param solution The current solution which has to be changed
+	*/
+	virtual void commitMove(Solution& solution);
 
+	/**
+		This function forgets the proposed move, the solution stays unchanged.
+	*/
+	virtual void discardMove();
+
+	/***********************************************************************************************
+	 
+		Following functions make up the in-place interface, they only need to be overridden when 
+		getNeighbourMode() returns IN_PLACE_NEIGHBOUR
+	 
+	***********************************************************************************************/
+
+	/**
+		This function changes the solution into one of its random neighbours. Enough information 
+		should be remembered to be able to undo this change.
+			@param solution The current solution which has to be changed
+	*/
+	virtual void applyRandomMove(Solution& solution);
+
+	/**
+		This function reverts the last change made by applyRandomMove().
+			@param solution The solution that was changed by applyRandomMove()
+	*/
+	virtual void undoMove(Solution& solution);
 
-	Solution* solution;
-	double temp;
+	/***********************************************************************************************
+	 
+		Following functions make up the max change acceptance test
+	 
+	***********************************************************************************************/
+
+	/**
+		This function selects the way uphill moves are accepted. The standard test evaluates the 
+		candidate and accepts it with calcProbability(). The max change test first draws the 
+		random number and turns it into the largest change that will still be accepted 
+		(calcMaxChange()), the candidate then only has to be evaluated as far as needed to know 
+		whether it stays below that bound. At low temperatures, where most candidates are 
+		rejected, that can save most of the evaluation.
+
+		CAUTION: calcProbability() isn't used by the max change test, a child class that overrides 
+					it has to override calcMaxChange() to match it.
+
+		Standard implementation returns false.
+			@return Whether or not the max change test is used
+	*/
+	virtual bool useMaxChangeAcceptance() const;
+
+	/**
+		This function draws the largest change in distance that will be accepted in this iteration, 
+		a move with a change \f$ \Delta \f$ has to be accepted with probability 
+		calcProbability(\f$ \Delta \f$, temp).
+
+		Standard implementation asks the Acceptance rule, for the standard MetropolisAcceptance:
+		\f$ -T ln(u) \f$ with u uniform in (0,1]
+			@param temp The current temperature
+			@return The max change, moves with a smaller change (and all improvements) are accepted
+	*/
+	virtual double calcMaxChange(double temp) const;
+
+	/**
+		This function is calcDistanceToTarget() for the max change test: when the distance of the 
+		solution is at least maxDistance the candidate will be rejected, so the evaluation can stop 
+		as soon as that is certain and return any value >= maxDistance. Smaller distances have to be 
+		exact.
+
+		Standard implementation returns calcDistanceToTarget().
+			@param solution The candidate solution
+			@param maxDistance The distance from which the candidate will be rejected
+			@return The distance to the target or a value >= maxDistance
+	*/
+	virtual double calcDistanceToTargetBounded(const Solution& solution, double maxDistance) const;
+
+	/**
+		This function is calcMoveChange() for the max change test: when the change is at least 
+		maxChange the move will be discarded, so the evaluation can stop as soon as that is certain 
+		and return any value >= maxChange. Smaller changes have to be exact.
+
+		Standard implementation returns calcMoveChange().
+			@param solution The current solution
+			@param distance The (cached) distance of the current solution to the target
+			@param maxChange The change from which the move will be discarded, never negative
+			@return The change in distance or a value >= maxChange
+	*/
+	virtual double calcMoveChangeBounded(const Solution& solution, double distance, double maxChange);
+
+	/***********************************************************************************************
+	 
+		Following functions make up rejection-free steps
+	 
+	***********************************************************************************************/
+
+	/**
+		This function selects rejection-free steps (the n-fold way) for problems with the move 
+		interface that can enumerate their moves: every step draws its move among the moves that 
+		would be accepted, each in proportion to its acceptance probability, and commits it. The 
+		proposals a normal step would have rejected first are counted in the iterations but never 
+		made, at low temperatures, where almost every proposal is rejected, that saves most of the 
+		work. The standard calcNewTemp() then cools down by all the iterations the step stood for.
+
+		Standard implementation returns false.
+			@return Whether or not the next step is rejection-free, e.g. only below a temperature
+	*/
+	virtual bool useRejectionFreeSteps() const;
+
+	/**
+		This function chooses the move of a rejection-free step, the move then goes through 
+		calcMoveChange() and commitMove() like a move of proposeMove(). A move with change 
+		\f$ \Delta \f$ has to be chosen with a probability in proportion to 
+		min(1, calcProbability(\f$ \Delta \f$, temp)), moves that don't change the solution 
+		don't count.
+
+		Standard implementation asserts, it has to be overridden when useRejectionFreeSteps() can 
+		return true.
+			@param solution The current solution
+			@param temp The current temperature
+			@return The chance that a proposal of a normal step would be accepted, 0 when no move 
+					can be accepted (the step then does nothing)
+	*/
+	virtual double proposeRejectionFreeMove(const Solution& solution, double temp);
+
+	/***********************************************************************************************
+	 
+		Following functions only need to be overridden by problems that keep state of their own 
+		which influences the search (e.g. a counter used by shouldStopHook())
+	 
+	***********************************************************************************************/
+
+	/**
+		This function adds the state of the problem to a checkpoint (see saveCheckpoint()).
+
+		Standard implementation writes nothing.
+			@param writer The writer of the checkpoint
+	*/
+	virtual void writeProblemState(CheckpointWriter& writer) const;
+
+	/**
+		This function reads back what writeProblemState() wrote.
+
+		Standard implementation reads nothing.
+			@param reader The reader of the checkpoint
+			@return Whether or not the state could be read
+	*/
+	virtual bool readProblemState(CheckpointReader& reader);
 
 };
 
-template <class Solution, class Target>
-bool SimulatedAnnealing<Solution,Target>::shouldStop(const Solution& solution){
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::SimulatedAnnealing(const Solution& startSolution, const Target& target, 
+					double starttemp, double precision, double alpha, uint64_t seed):Base(startSolution, target, starttemp, precision, alpha, seed){
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::~SimulatedAnnealing(){
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::shouldStopHook(const Solution& solution){
+	return Base::shouldStopHook(solution);
+}
 
-	if(shouldStopHook(solution)){
-		std::cout << std::endl << "STOP REASON: ShouldStopHook" << std::endl;
-		return true;
-	}else if(calcDistanceToTarget(solution) < PRECISION){
-		std::cout << std::endl << "STOP REASON: Distance to target is smaller than the required precision. Solution found." << std::endl;
-		return true;
-	}else{
-		return false;
-	}
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::printStatus(const Solution& solution, double temp){
+	Base::printStatus(solution, temp);
+}
 
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::calcProbability(double change, double temp) const{ // should be overwritten
+	return Base::calcProbability(change, temp);
 }
 
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::calcNewTemp(double lastTemp) const{
+	return Base::calcNewTemp(lastTemp);
+}
 
-template <class Solution, class Target>
-double SimulatedAnnealing<Solution,Target>::calcDistanceChange(const Solution& oldSolution, const Solution& newSolution) const{
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+typename SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::NeighbourMode SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::getNeighbourMode() const{
+	return Base::getNeighbourMode();
+}
 
-	double oldDistance = calcDistanceToTarget(oldSolution);
-	double newDistance = calcDistanceToTarget(newSolution);
-	assert(oldDistance >= 0 && newDistance >= 0); // distances are always positive
-	return (newDistance-oldDistance);
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::proposeMove(const Solution& solution){
+	Base::proposeMove(solution);
+}
 
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::calcMoveChange(const Solution& solution, double distance){
+	return Base::calcMoveChange(solution, distance);
 }
 
-template <class Solution, class Target>
-double SimulatedAnnealing<Solution,Target>::calcProbability(double change, double temp) const{ // should be overwritten
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::commitMove(Solution& solution){
+	Base::commitMove(solution);
+}
 
-	return exp(-1.0*change/temp);
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::discardMove(){
+	Base::discardMove();
+}
 
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::applyRandomMove(Solution& solution){
+	Base::applyRandomMove(solution);
 }
 
-template <class Solution, class Target>
-double SimulatedAnnealing<Solution,Target>::calcNewTemp(double lastTemp) const{
-	return lastTemp*ALPHA;
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::undoMove(Solution& solution){
+	Base::undoMove(solution);
 }
 
-template <class Solution, class Target>
-bool SimulatedAnnealing<Solution,Target>::accept(const Solution& oldSolution, const Solution& newSolution, double temp) const{
-
-	//std::cout << "Testing acceptance: Old Solution: " << oldSolution << " New Solution: " << newSolution << std::endl;
-	double change = calcDistanceChange(oldSolution, newSolution);
-	//std::cout << "\t ->Change: " << change << std::endl;
-	if(change < 0){
-		//std::cout << "Result is better so: ";
-		return true;
-	}else{
-		double probability = calcProbability(change, temp);
-		//DEBUG:BEGIN
-		if(!(probability >=0 && probability <=1)){
-			std::cout << "Probability wrong: " << probability << " temp: " << temp << std::endl;
-			std::cin.get();
-		}
-		//DEBUG:END
-		assert(probability >=0 && probability <= 1); // probability has to be checked
-		//std::cout << "Probability we're gonna accept: " << probability << " result: ";
-		return (rand()%((int)(1.0/probability))==0);
-	}
 
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::useMaxChangeAcceptance() const{
+	return Base::useMaxChangeAcceptance();
 }
 
-template <class Solution, class Target>
-void SimulatedAnnealing<Solution,Target>::solve(){
-
-	printStatus(*solution, temp);
-	while(!shouldStop(*solution)){
-		Solution* newSolution = giveRandomNeighbour(*solution);
-		if(accept(*solution, *newSolution, temp)){
-			delete solution;
-			solution = newSolution;
-			//std::cout << "ACCEPTED" << std::endl;
-		}else{
-			//std::cout << "REJECTED" << std::endl;
-			delete newSolution;
-		}
-		//std::cout << "\n*****************\n" << std::endl;
-		printStatus(*solution, temp);
-		temp = calcNewTemp(temp);
-		assert(temp >= 0); // only positive temperatures are allowed!
-	}
-	std::cout << "\n\n\n*************************************************************\n\n" 
-		<< "We're done, Solution: \n\n" << *solution << "\n\n*************************************************************\n" << std::endl;
-	
-	delete solution;
-	delete TARGET;
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::calcMaxChange(double temp) const{
+	return Base::calcMaxChange(temp);
+}
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::calcDistanceToTargetBounded(const Solution& solution, double maxDistance) const{
+	return Base::calcDistanceToTargetBounded(solution, maxDistance);
+}
 
-	std::cout << "\n\n\nPress enter to continue..." << std::endl;
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::calcMoveChangeBounded(const Solution& solution, double distance, double maxChange){
+	return Base::calcMoveChangeBounded(solution, distance, maxChange);
+}
 
-	std::cin.get();
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::useRejectionFreeSteps() const{
+	return Base::useRejectionFreeSteps();
 }
 
-template <class Solution, class Target>
-bool SimulatedAnnealing<Solution,Target>::shouldStopHook(const Solution& solution){
-	return false;
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::proposeRejectionFreeMove(const Solution& solution, double temp){
+	return Base::proposeRejectionFreeMove(solution, temp);
 }
 
-template <class Solution, class Target>
-void SimulatedAnnealing<Solution,Target>::printStatus(const Solution& solution, double temp){
-	std::cout << "Current solution: " << solution << " at Temp: " << temp << std::endl;
+
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::writeProblemState(CheckpointWriter& writer) const{
+	Base::writeProblemState(writer);
 }
 
-template <class Solution, class Target>
-SimulatedAnnealing<Solution,Target>::SimulatedAnnealing(const Solution& startSolution, const Target& target, 
-					double starttemp, double precision, double alpha):solution(new Solution(startSolution)),TARGET(new Target(target))
-					,temp(starttemp),PRECISION(precision),ALPHA(alpha){
-	assert(starttemp >= 0); // only positive temperatures are allowed!
+template <class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool SimulatedAnnealing<Solution,Target,RNG,Cooling,Acceptance,Allocator>::readProblemState(CheckpointReader& reader){
+	return Base::readProblemState(reader);
 }
 
 
@@ -0,0 +1,139 @@
+#ifndef __SOLUTION_ALLOCATORS_H
+#define __SOLUTION_ALLOCATORS_H
+
+#include <vector>
+#include <stddef.h>	// needed for size_t
+#include <assert.h>
+
+
+
+/***********************************************************************************************//**
+
+	\brief Solution allocators for the Simulated Annealing Framework
+
+	A solution allocator is a policy class given as template parameter to
+	(Static)SimulatedAnnealing, every object owns its own one. The framework gets every solution
+	it keeps (the copy of the start solution and of the best solution) from it and hands every
+	solution it throws away (rejected candidates, replaced solutions) back to it. With the
+	COPY_NEIGHBOUR interface giveRandomNeighbour() should get its candidate from copySolution(),
+	which asks the allocator, instead of calling new itself.
+
+	A solution allocator has to offer:
+	- Solution* copy(const Solution& solution)
+	- void release(Solution* solution), also for solutions made with new by a hook and solutions
+	  that came from another object (e.g. exchanged by ParallelTempering), 0 is ignored
+
+	HeapSolutionAllocator, the standard, simply uses new and delete. SolutionPool keeps the
+	released solutions in a free list and copies into them with the assignment operator, for
+	solution types whose assignment reuses their storage (like NQueensBoard) a search then
+	doesn't touch the global heap (and its lock) at all once the pool is warm.
+
+***************************************************************************************************/
+
+template <class Solution>
+class HeapSolutionAllocator{
+public:
+	Solution* copy(const Solution& solution){
+		return new Solution(solution);
+	}
+	void release(Solution* solution){
+		delete solution;
+	}
+};
+
+/**
+	Free list of solutions, the solution type needs an assignment operator. It isn't thread safe,
+	which it doesn't have to be as every object has its own one.
+*/
+template <class Solution>
+class SolutionPool{
+
+public:
+
+	/**
+		Constructor
+			@param capacity The maximum number of free solutions kept, solutions released when
+							the free list is full are deleted
+	*/
+	explicit SolutionPool(size_t capacity = 16);
+
+	/**
+		Deletes the free solutions
+	*/
+	~SolutionPool();
+
+	/**
+		The copy constructor (used when an object with a pool is copied) starts an empty pool
+		of the same capacity, free solutions are never shared
+	*/
+	SolutionPool(const SolutionPool& other);
+
+	Solution* copy(const Solution& solution);
+	void release(Solution* solution);
+
+	//number of solutions in the free list
+	size_t getFree() const;
+
+	//number of copies that had to be made with new because the free list was empty
+	long getMisses() const;
+
+private:
+	std::vector<Solution*> freeSolutions;
+	size_t capacity;
+	long misses;
+
+	SolutionPool& operator=(const SolutionPool&);
+};
+
+template <class Solution>
+SolutionPool<Solution>::SolutionPool(size_t capacity):capacity(capacity),misses(0){
+	freeSolutions.reserve(capacity);
+}
+
+template <class Solution>
+SolutionPool<Solution>::SolutionPool(const SolutionPool& other):capacity(other.capacity),misses(0){
+	freeSolutions.reserve(capacity);
+}
+
+template <class Solution>
+SolutionPool<Solution>::~SolutionPool(){
+	for(size_t i=0; i<freeSolutions.size(); i++){
+		delete freeSolutions[i];
+	}
+}
+
+template <class Solution>
+inline Solution* SolutionPool<Solution>::copy(const Solution& solution){
+	if(freeSolutions.empty()){
+		misses++;
+		return new Solution(solution);
+	}
+	Solution* recycled = freeSolutions.back();
+	freeSolutions.pop_back();
+	*recycled = solution;
+	return recycled;
+}
+
+template <class Solution>
+inline void SolutionPool<Solution>::release(Solution* solution){
+	if(solution == 0){
+		return;
+	}
+	if(freeSolutions.size() < capacity){
+		freeSolutions.push_back(solution);
+	}else{
+		delete solution;
+	}
+}
+
+template <class Solution>
+size_t SolutionPool<Solution>::getFree() const{
+	return freeSolutions.size();
+}
+
+template <class Solution>
+long SolutionPool<Solution>::getMisses() const{
+	return misses;
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef __SOLVE_OPTIONS_H
+#define __SOLVE_OPTIONS_H
+
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include "solver_stats.h"
+
+
+
+/***********************************************************************************************//**
+
+	\brief Options and result of the anytime solve(options) of the Simulated Annealing Framework
+
+	solve(options) runs the search until the solution is within PRECISION of the TARGET,
+	shouldStopHook() says so or one of the limits below is hit, whichever comes first. It
+	doesn't print anything, doesn't wait for input and leaves the object usable, so it can be
+	called again to continue the search (e.g. with a new deadline).
+
+***************************************************************************************************/
+
+struct SolveOptions{
+
+	std::chrono::steady_clock::time_point deadline; // wall clock time at which to stop
+	long maxIterations; // maximum number of iterations of this call, negative for no limit
+	long maxEvaluations; // maximum number of evaluated candidates of this call, negative for no limit
+	const std::atomic<bool>* cancel; // the search stops as soon as this becomes true, 0 for none
+
+	SolveOptions():deadline(std::chrono::steady_clock::time_point::max()),maxIterations(-1),maxEvaluations(-1),cancel(0){}
+
+	/**
+		Sets the deadline to the given number of seconds from now
+	*/
+	SolveOptions& setTimeLimit(double seconds){
+		deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+		return *this;
+	}
+
+};
+
+enum StopReason{ STOP_PRECISION, STOP_HOOK, STOP_DEADLINE, STOP_ITERATIONS, STOP_EVALUATIONS, STOP_CANCELLED };
+
+inline const char* stopReasonName(StopReason reason){
+	switch(reason){
+		case STOP_PRECISION: return "precision reached";
+		case STOP_HOOK: return "shouldStopHook";
+		case STOP_DEADLINE: return "deadline";
+		case STOP_ITERATIONS: return "iteration budget";
+		case STOP_EVALUATIONS: return "evaluation budget";
+		case STOP_CANCELLED: return "cancelled";
+	}
+	return "unknown";
+}
+
+template <class Solution>
+struct SolveResult{
+
+	std::shared_ptr<const Solution> bestSolution; // copy of the best solution found so far
+	double bestDistance;
+	double distance; // distance of the current solution, where the search continues
+	StopReason stopReason;
+	long iterations; // iterations done by this call
+	long evaluations; // candidates evaluated by this call
+	double seconds; // wall clock time of this call
+	SolverStats stats; // statistics of the whole run (see solver_stats.h)
+
+};
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef __SOLVER_STATS_H
+#define __SOLVER_STATS_H
+
+#include <iostream>	// needed for basic IO
+#include <chrono>	// needed for the phase timers
+#include <cmath>	// needed for HUGE_VAL
+
+
+
+/***********************************************************************************************//**
+
+	\brief Statistics of a run of the Simulated Annealing Framework
+
+	Every (Static)SimulatedAnnealing object keeps a SolverStats that is updated by step() (and so
+	by solve() and the drivers built on top of step()). Only when SIMULATED_ANNEALING_STATS is
+	defined before the framework is included the statistics are kept, without it the updates
+	are compiled away and the search loop costs exactly what it did before, getStats() then
+	returns an object that stays empty (check SolverStats::ENABLED).
+
+	The time of an iteration is split in three phases:
+	- generation: giveRandomNeighbour(), proposeMove() or applyRandomMove()
+	- evaluation: calcDistanceToTarget(), calcMoveChange() or their bounded variants
+	- acceptance: the acceptance test and committing or rolling back the candidate
+
+***************************************************************************************************/
+
+#ifdef SIMULATED_ANNEALING_STATS
+#define SA_STATS(statement) statement
+#else
+#define SA_STATS(statement)
+#endif
+
+class SolverStats{
+
+public:
+
+#ifdef SIMULATED_ANNEALING_STATS
+	static const bool ENABLED = true;
+#else
+	static const bool ENABLED = false;
+#endif
+
+	//number of iterations in the sliding window of getAcceptanceRate()
+	static const int WINDOW = 1024;
+
+	long iterations;
+	long proposals;
+	long acceptances;
+	long uphillAcceptances; // accepted candidates that were worse than the current solution
+
+	double generationSeconds;
+	double evaluationSeconds;
+	double acceptanceSeconds;
+
+	double bestDistance;
+	long bestIteration; // iteration in which bestDistance was reached
+
+	SolverStats();
+
+	/**
+		@return The fraction of accepted candidates over the last WINDOW iterations (or fewer at
+				the start of the run)
+	*/
+	double getAcceptanceRate() const;
+
+	/**
+		Records the outcome of one iteration
+			@param accepted Whether or not the candidate was accepted
+			@param change The change in distance the candidate caused
+			@param distance The distance of the current solution after the iteration
+	*/
+	void recordStep(bool accepted, double change, double distance);
+
+	/**
+		Records iterations whose candidates were rejected without being made, a rejection-free
+		step stands for these and the accepted iteration recorded by recordStep()
+			@param rejected The number of rejected iterations
+	*/
+	void recordRejections(long rejected);
+
+	/**
+		Records the distance of a (new) start solution
+	*/
+	void recordStart(double distance);
+
+	/**
+		The phase timers, startPhase() starts timing and each end function adds the time since
+		the last start or end to its phase
+	*/
+	void startPhase();
+	void endGeneration();
+	void endEvaluation();
+	void endAcceptance();
+
+	void print(std::ostream& output) const;
+
+private:
+	bool window[WINDOW]; // outcome of the last iterations, used as ring buffer
+	int windowAccepted; // number of trues in window
+	std::chrono::steady_clock::time_point phaseStart;
+
+	double lapSeconds();
+};
+
+inline SolverStats::SolverStats():iterations(0),proposals(0),acceptances(0),uphillAcceptances(0)
+		,generationSeconds(0),evaluationSeconds(0),acceptanceSeconds(0),bestDistance(HUGE_VAL),bestIteration(0),windowAccepted(0){
+	for(int i=0; i<WINDOW; i++){
+		window[i] = false;
+	}
+}
+
+inline double SolverStats::getAcceptanceRate() const{
+	long n = iterations < WINDOW ? iterations : WINDOW;
+	return n == 0 ? 0 : (double)windowAccepted/n;
+}
+
+inline void SolverStats::recordStep(bool accepted, double change, double distance){
+	int slot = (int)(iterations % WINDOW);
+	windowAccepted += (accepted ? 1 : 0) - (window[slot] ? 1 : 0);
+	window[slot] = accepted;
+
+	iterations++;
+	proposals++;
+	if(accepted){
+		acceptances++;
+		if(change > 0){
+			uphillAcceptances++;
+		}
+		if(distance < bestDistance){
+			bestDistance = distance;
+			bestIteration = iterations;
+		}
+	}
+}
+
+inline void SolverStats::recordRejections(long rejected){
+	long slots = rejected < WINDOW ? rejected : WINDOW;
+	for(long i=0; i<slots; i++){
+		int slot = (int)((iterations+i) % WINDOW);
+		windowAccepted -= window[slot] ? 1 : 0;
+		window[slot] = false;
+	}
+	iterations += rejected;
+	proposals += rejected;
+}
+
+inline void SolverStats::recordStart(double distance){
+	if(distance < bestDistance){
+		bestDistance = distance;
+		bestIteration = iterations;
+	}
+}
+
+inline void SolverStats::startPhase(){
+	phaseStart = std::chrono::steady_clock::now();
+}
+
+inline void SolverStats::endGeneration(){
+	generationSeconds += lapSeconds();
+}
+
+inline void SolverStats::endEvaluation(){
+	evaluationSeconds += lapSeconds();
+}
+
+inline void SolverStats::endAcceptance(){
+	acceptanceSeconds += lapSeconds();
+}
+
+inline double SolverStats::lapSeconds(){
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	double seconds = std::chrono::duration<double>(now - phaseStart).count();
+	phaseStart = now;
+	return seconds;
+}
+
+inline void SolverStats::print(std::ostream& output) const{
+	output << "Iterations: " << iterations << std::endl;
+	output << "Accepted: " << acceptances << " of " << proposals << " (" << uphillAcceptances << " uphill)" << std::endl;
+	output << "Acceptance rate (last " << WINDOW << "): " << getAcceptanceRate() << std::endl;
+	output << "Best distance: " << bestDistance << " in iteration " << bestIteration << std::endl;
+	output << "Time generating: " << generationSeconds << "s, evaluating: " << evaluationSeconds
+		<< "s, accepting: " << acceptanceSeconds << "s" << std::endl;
+}
+
+#endif
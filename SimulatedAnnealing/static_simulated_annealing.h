@@ -0,0 +1,1101 @@
+#ifndef __STATIC_SIMULATED_ANNEALING_H
+#define __STATIC_SIMULATED_ANNEALING_H
+
+#include <iostream>	// needed for basic IO
+#include <sstream>	// needed to format the status lines
+#include <cmath>	// needed for chance calculation
+#include <climits>	// needed for LONG_MAX
+#include <assert.h> // will use assert to check certain values
+#include "random_engine.h"	// default random number engine
+#include "cooling_schedules.h"	// default cooling schedule
+#include "acceptance_rules.h"	// default acceptance rule
+#include "solver_stats.h"	// statistics, kept when SIMULATED_ANNEALING_STATS is defined
+#include "log_sink.h"	// output of the status lines
+#include "checkpoint.h"	// snapshots of the search
+#include "solve_options.h"	// options and result of solve(options)
+#include "solution_allocators.h"	// default solution allocator
+
+
+
+/***********************************************************************************************//** 
+
+	\brief Simulated Annealing Framework, static polymorphism variant: 
+	The same framework as SimulatedAnnealing but the hooks are resolved at compile time.
+	
+	Static Simulated Annealing Class
+
+	This class uses the curiously recurring template pattern: a child class passes itself as 
+	the first template parameter and hides the hooks it wants to change with functions of the 
+	same name and signature. The hook calls in the search loop are then resolved at compile time 
+	and can be inlined, which matters for problems with cheap neighbours and distances.
+	The hooks have to be public in the child class, or the child class has to declare 
+	StaticSimulatedAnnealing a friend.
+
+	Require implementing:
+	- giveRandomNeighbour()
+	- calcDistanceToTarget()
+
+	Optionale hiding:
+	- shouldStopHook()
+	- printStatus()
+	- calcProbability()
+	- calcNewTemp()
+	- getNeighbourMode() and the move or in-place interface it selects
+	- useMaxChangeAcceptance(), calcMaxChange() and the bounded evaluations
+	- useRejectionFreeSteps() and proposeRejectionFreeMove()
+	- writeProblemState() and readProblemState()
+
+	SimulatedAnnealing, the variant with virtual hooks, is built on top of this class, see 
+	simulated_annealing.h for the documentation of the hooks and the template parameters.
+
+***************************************************************************************************/
+
+template <class Derived, class Solution, class Target, class RNG = Xoshiro256, 
+			class Cooling = GeometricCooling, class Acceptance = MetropolisAcceptance, 
+			class Allocator = HeapSolutionAllocator<Solution> >
+class StaticSimulatedAnnealing{
+
+public:	
+	
+	/** 
+		Constructor
+			@param startSolution The solution in the domain where you want to start the search
+			@param TARGET The TARGET value you are looking for
+			@param starttemp The starttemperature, the higher this temperature, the longer the 
+								algorythm will allow uphill moves
+			@param PRECISION The required PRECISION for a solution to be acceptable
+			@param alpha The main parameter of the cooling schedule (the factor by which the 
+								standard GeometricCooling lowers the temperature)
+			@param seed The seed of the random number engine of this object
+	*/
+	StaticSimulatedAnnealing(const Solution& startSolution, const Target& target, double starttemp, double precision, double alpha, uint64_t seed = 0);
+
+	/**
+		Destructor, deletes the current solution and TARGET if solve() didn't already do so 
+		(and the best solution when it was kept)
+	*/
+	~StaticSimulatedAnnealing();
+
+	/**
+		The ways in which a new candidate can be obtained from the current solution
+			- COPY_NEIGHBOUR: giveRandomNeighbour() returns a new solution which is evaluated 
+								with calcDistanceToTarget()
+			- MOVE_NEIGHBOUR: a move is proposed on the current solution and only the change in 
+								distance it causes is asked for, the move is then committed or 
+								discarded
+			- IN_PLACE_NEIGHBOUR: a random move is applied to the current solution itself, which 
+								is evaluated with calcDistanceToTarget() and rolled back when the 
+								move is rejected
+	*/
+	enum NeighbourMode{ COPY_NEIGHBOUR, MOVE_NEIGHBOUR, IN_PLACE_NEIGHBOUR };
+
+	typedef Solution SolutionType;
+	
+	/**
+		The public method that is called from a child class-Object
+	*/
+	void solve();
+
+	/**
+		Anytime variant of solve(): searches until the solution is within PRECISION of the TARGET, 
+		shouldStopHook() returns true or one of the limits of the options is hit. Nothing is 
+		printed and the object stays usable, calling it again continues the search. The best 
+		solution is kept during the call (see setKeepBest()).
+			@param options The deadline, budgets and cancel flag (see solve_options.h)
+			@return The best solution found so far, why the search stopped and the statistics
+	*/
+	SolveResult<Solution> solve(const SolveOptions& options);
+
+	/**
+		Resumable form of solve(options), lets a scheduler interleave many searches on a few 
+		threads (see cooperative_scheduler.h): beginSolve() starts the search, every resume() 
+		continues it for at most the given number of iterations and getResult() returns the 
+		result so far. solve(options) is beginSolve() followed by resume() until it returns false.
+			@param options The deadline, budgets and cancel flag (see solve_options.h)
+	*/
+	void beginSolve(const SolveOptions& options);
+
+	/**
+		@param maxIterations The maximum number of iterations before control is given back
+		@return Whether or not the search can go on, false once it stopped
+	*/
+	bool resume(long maxIterations);
+
+	SolveResult<Solution> getResult() const;
+
+	/***********************************************************************************************
+	
+		Following functions allow other drivers (e.g. ParallelTempering) to run the search 
+		step by step
+	
+	***********************************************************************************************/
+
+	/**
+		(Re)calculates the cached distance of the current solution, has to be called once before 
+		the first step() (solve() does this itself)
+	*/
+	void evaluateSolution();
+
+	/**
+		Does one iteration at the current temperature: a neighbour is generated and accepted 
+		or rejected, the temperature is not changed.
+			@return Whether or not the neighbour was accepted
+	*/
+	bool step();
+
+	/**
+		Lowers the temperature using calcNewTemp()
+	*/
+	void coolDown();
+
+	const Solution& getSolution() const;
+	double getDistance() const;
+	double getTemp() const;
+	void setTemp(double temp);
+
+	/**
+		@return Whether or not the current solution is within PRECISION of the TARGET
+	*/
+	bool reachedPrecision() const;
+
+	/**
+		Exchanges the current solutions (and their cached distances) of two objects of the same 
+		problem, their temperatures and random number engines stay where they are.
+			@param other The object to exchange solutions with
+	*/
+	void swapSolution(Derived& other);
+
+	/**
+		Replaces the cooling schedule or acceptance rule, e.g. to set parameters other than the 
+		one passed to the constructor
+	*/
+	void setCooling(const Cooling& cooling);
+	void setAcceptance(const Acceptance& acceptance);
+	Cooling& getCooling();
+	Acceptance& getAcceptance();
+
+	long getIteration() const;
+
+	//number of candidates evaluated so far (including the start solution)
+	long getEvaluations() const;
+
+	/**
+		@return The statistics of the run so far, only kept when SIMULATED_ANNEALING_STATS is 
+				defined (see solver_stats.h)
+	*/
+	const SolverStats& getStats() const;
+
+	/**
+		Replaces the sink the status lines are written to (consoleLogSink() by default)
+			@param sink The new sink, it has to outlive this object
+	*/
+	void setLogSink(LogSink& sink);
+
+	/**
+		Sets how often solve() calls printStatus(), see StatusSampler (by default every 100 ms)
+			@param everyIterations Print every so many iterations, 0 to disable
+			@param everyMilliseconds Print every so many milliseconds, 0 to disable
+	*/
+	void setStatusInterval(long everyIterations, double everyMilliseconds);
+
+	/**
+		Keeps a copy of the best solution found so far (off by default). The copy is only made 
+		when the search is about to leave a best solution for a worse one, with the in-place 
+		interface on every improvement.
+	*/
+	void setKeepBest(bool keep);
+
+	/**
+		@return The best solution found so far, 0 if setKeepBest() wasn't turned on
+	*/
+	const Solution* getBestSolution() const;
+	double getBestDistance() const;
+
+	/**
+		Writes a snapshot of the search: the current and best solution (using the writeCheckpoint() 
+		hook of the solution type, see checkpoint.h), the temperature, the iteration, the state of 
+		the random number engine, the cooling schedule and the acceptance rule, the statistics and 
+		the state of the problem (writeProblemState())
+			@param writer The writer the snapshot is appended to
+	*/
+	void saveCheckpoint(CheckpointWriter& writer) const;
+
+	/**
+		Continues the search from a snapshot written by saveCheckpoint(), this object has to be 
+		constructed with the same parameters as the one that wrote it
+			@param reader The reader positioned at the start of the snapshot
+			@return Whether or not the snapshot could be read, when it couldn't this object 
+					is left in an undefined state
+	*/
+	bool loadCheckpoint(CheckpointReader& reader);
+
+	/**
+		The same for files, a file is replaced only once the new snapshot is completely written
+	*/
+	bool saveCheckpoint(const std::string& path) const;
+	bool loadCheckpoint(const std::string& path);
+
+	/**
+		Lets solve() write a checkpoint every so many iterations and/or milliseconds, the snapshot 
+		is made by the search thread and written to the file by a background thread
+			@param path The checkpoint file
+			@param everyIterations Write every so many iterations, 0 to disable
+			@param everyMilliseconds Write every so many milliseconds, 0 to disable
+	*/
+	void setCheckpointFile(const std::string& path, long everyIterations, double everyMilliseconds);
+
+protected:
+
+	/***********************************************************************************************
+	 
+		Following functions CAN be hidden by the child class, these are the standard 
+		implementations (see simulated_annealing.h for what each hook has to do)
+	 
+	***********************************************************************************************/
+
+	//always returns false
+	bool shouldStopHook(const Solution& solution);
+
+	//prints the solution and the temperature
+	void printStatus(const Solution& solution, double temp);
+
+	//asks the acceptance rule, \f$ exp(\frac{-\Delta(f(s))}{T}) \f$ for the standard MetropolisAcceptance
+	double calcProbability(double change, double temp) const;
+
+	//asks the cooling schedule, \f$ \alpha T \f$ for the standard GeometricCooling, after a 
+	//rejection-free step the schedule is advanced by all the iterations the step stood for
+	double calcNewTemp(double lastTemp) const;
+
+	//returns COPY_NEIGHBOUR
+	NeighbourMode getNeighbourMode() const;
+
+	//move interface, has to be hidden when getNeighbourMode() returns MOVE_NEIGHBOUR
+	void proposeMove(const Solution& solution);
+	double calcMoveChange(const Solution& solution, double distance);
+	void commitMove(Solution& solution);
+	void discardMove();
+
+	//in-place interface, has to be hidden when getNeighbourMode() returns IN_PLACE_NEIGHBOUR
+	void applyRandomMove(Solution& solution);
+	void undoMove(Solution& solution);
+
+	//state of the problem for checkpoints, the standard implementations write and read nothing
+	void writeProblemState(CheckpointWriter& writer) const;
+	bool readProblemState(CheckpointReader& reader);
+
+	//returns false
+	bool useMaxChangeAcceptance() const;
+
+	//asks the acceptance rule, \f$ -T ln(u) \f$ for the standard MetropolisAcceptance
+	double calcMaxChange(double temp) const;
+
+	//bounded evaluations, the standard implementations ignore the bound
+	double calcDistanceToTargetBounded(const Solution& solution, double maxDistance) const;
+	double calcMoveChangeBounded(const Solution& solution, double distance, double maxChange);
+
+	//returns false
+	bool useRejectionFreeSteps() const;
+
+	//has to be hidden when useRejectionFreeSteps() returns true
+	double proposeRejectionFreeMove(const Solution& solution, double temp);
+
+
+
+	/***********************************************************************************************
+	 
+		Following functions are standard and SHOULD NOT be hidden
+	 
+	***********************************************************************************************/
+	
+	bool shouldStop(const Solution& solution, double distance);
+
+	bool accept(double change, double temp) const;
+
+	bool takeStep();
+	bool takeMaxChangeStep();
+	bool takeRejectionFreeStep();
+
+	//hands a status line to the log sink, to be used by printStatus()
+	void writeLog(const std::string& line) const;
+
+	//records the current solution as the best so far when it is and setKeepBest() is on, the 
+	//copy is only made by storePendingBest() once the search is about to leave the solution
+	void updateBest();
+
+	//copies the current solution into bestSolution when updateBest() deferred that
+	void storePendingBest() const;
+
+	/**
+		@return A copy of solution from the solution allocator (see solution_allocators.h), 
+				giveRandomNeighbour() should make its candidate with this function so the 
+				framework can recycle rejected candidates
+	*/
+	Solution* copySolution(const Solution& solution) const;
+
+	void submitCheckpoint();
+
+	Derived& derived();
+	const Derived& derived() const;
+
+	const Target* TARGET;
+	const double PRECISION;
+	const double ALPHA;
+
+	mutable Allocator allocator; // gives out and takes back the solutions, also used by copySolution
+	Solution* solution;
+	double distance; // cached distance of solution to TARGET
+	double temp;
+	const double START_TEMP;
+	long iteration; // number of steps done
+	long evaluations; // number of candidates evaluated
+	bool lastAccepted; // whether or not the last step was accepted
+	long stepIterations; // number of iterations the last step stood for, more than 1 after a rejection-free step
+
+	mutable Cooling cooling; // schedules may keep state, calcNewTemp is const
+	Acceptance acceptance;
+
+	mutable RNG rng; // random number engine, also used by const functions like giveRandomNeighbour
+	mutable ExponentialDraws exponentials; // -ln(u) values for calcMaxChange
+
+	SolverStats stats;
+
+	LogSink* logSink;
+	StatusSampler statusSampler;
+
+	bool keepBest;
+	mutable Solution* bestSolution; // 0 until the first solution is kept
+	double bestDistance;
+	mutable bool bestPending; // the current solution is the best one but hasn't been copied yet
+
+	AsyncCheckpointWriter* checkpointWriter; // 0 when solve() doesn't write checkpoints
+	StatusSampler checkpointSampler;
+
+	//state of the search started by beginSolve()
+	SolveOptions runOptions;
+	std::chrono::steady_clock::time_point runStart;
+	long runStartIteration;
+	long runStartEvaluations;
+	bool runKeptBest; // setKeepBest() as it was before beginSolve()
+	bool running;
+	StopReason runStopReason;
+	long clockInterval; // the clock is read every clockInterval iterations
+	long nextClockCheck;
+	std::chrono::steady_clock::time_point lastClockCheck;
+
+	bool shouldStopRun();
+
+};
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::shouldStop(const Solution& solution, double distance){
+
+	if(derived().shouldStopHook(solution)){
+		writeLog("STOP REASON: ShouldStopHook");
+		return true;
+	}else if(distance < PRECISION){
+		writeLog("STOP REASON: Distance to target is smaller than the required precision. Solution found.");
+		return true;
+	}else{
+		return false;
+	}
+
+}
+
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::calcProbability(double change, double temp) const{ // should be overwritten
+
+	return acceptance.probability(change, distance, temp);
+
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::calcNewTemp(double lastTemp) const{
+	CoolingState state = {START_TEMP, iteration, lastAccepted};
+	if(stepIterations > 1){
+		return cooling.advance(lastTemp, state, stepIterations);
+	}
+	return cooling.next(lastTemp, state);
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::accept(double change, double temp) const{
+	if(change < 0){
+		return true;
+	}else{
+		double probability = derived().calcProbability(change, temp);
+		assert(probability >=0 && probability <= 1); // probability has to be checked
+		return rng.nextDouble() < probability;
+	}
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::step(){
+
+	iteration++;
+	evaluations++;
+	stepIterations = 1;
+	SA_STATS(double lastDistance = distance;)
+	SA_STATS(stats.startPhase();)
+	lastAccepted = takeStep();
+	SA_STATS(stats.endAcceptance();)
+	SA_STATS(stats.recordRejections(stepIterations-1);)
+	SA_STATS(stats.recordStep(lastAccepted, distance-lastDistance, distance);)
+	if(keepBest && lastAccepted){
+		updateBest();
+	}
+	return lastAccepted;
+
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::takeStep(){
+
+	if(derived().useRejectionFreeSteps()){
+		return takeRejectionFreeStep();
+	}
+
+	if(derived().useMaxChangeAcceptance()){
+		return takeMaxChangeStep();
+	}
+
+	NeighbourMode mode = derived().getNeighbourMode();
+	if(mode == MOVE_NEIGHBOUR){
+		derived().proposeMove(*solution);
+		SA_STATS(stats.endGeneration();)
+		double change = derived().calcMoveChange(*solution, distance);
+		SA_STATS(stats.endEvaluation();)
+		if(accept(change, temp)){
+			if(change > 0) storePendingBest();
+			derived().commitMove(*solution);
+			distance += change;
+			return true;
+		}else{
+			derived().discardMove();
+			return false;
+		}
+	}else if(mode == IN_PLACE_NEIGHBOUR){
+		derived().applyRandomMove(*solution);
+		SA_STATS(stats.endGeneration();)
+		double newDistance = derived().calcDistanceToTarget(*solution);
+		SA_STATS(stats.endEvaluation();)
+		assert(newDistance >= 0); // distances are always positive
+		if(accept(newDistance-distance, temp)){
+			distance = newDistance;
+			return true;
+		}else{
+			derived().undoMove(*solution);
+			return false;
+		}
+	}else{
+		Solution* newSolution = derived().giveRandomNeighbour(*solution);
+		SA_STATS(stats.endGeneration();)
+		double newDistance = derived().calcDistanceToTarget(*newSolution);
+		SA_STATS(stats.endEvaluation();)
+		assert(newDistance >= 0); // distances are always positive
+		if(accept(newDistance-distance, temp)){
+			if(newDistance > distance) storePendingBest();
+			allocator.release(solution);
+			solution = newSolution;
+			distance = newDistance;
+			return true;
+		}else{
+			allocator.release(newSolution);
+			return false;
+		}
+	}
+
+}
+
+//the move is drawn among the moves that will be accepted, the proposals a normal step would have 
+//rejected before it are only counted in the iterations (and so in the cooling, see calcNewTemp())
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::takeRejectionFreeStep(){
+
+	assert(derived().getNeighbourMode() == MOVE_NEIGHBOUR); // the move is made with the move interface
+	double acceptanceRate = derived().proposeRejectionFreeMove(*solution, temp);
+	SA_STATS(stats.endGeneration();)
+	if(acceptanceRate <= 0){
+		return false; // no move can be accepted
+	}
+	double change = derived().calcMoveChange(*solution, distance);
+	SA_STATS(stats.endEvaluation();)
+	if(change > 0) storePendingBest();
+	derived().commitMove(*solution);
+	distance += change;
+
+	//the number of rejections before an acceptance is geometrically distributed, the step stands 
+	//for them and the accepted iteration
+	if(acceptanceRate < 1){
+		double rejected = floor(log(1.0-rng.nextDouble())/log(1.0-acceptanceRate));
+		stepIterations += rejected < 1e15 ? (long)rejected : (long)1e15;
+		iteration += stepIterations-1;
+	}
+	return true;
+
+}
+
+//the random draw is done first, the candidate is then only evaluated as far as needed to know 
+//whether its change stays below the max change (improvements are always accepted)
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::takeMaxChangeStep(){
+
+	double maxChange = derived().calcMaxChange(temp);
+	double bound = maxChange > 0 ? maxChange : 0;
+	SA_STATS(stats.endAcceptance();)
+
+	NeighbourMode mode = derived().getNeighbourMode();
+	if(mode == MOVE_NEIGHBOUR){
+		derived().proposeMove(*solution);
+		SA_STATS(stats.endGeneration();)
+		double change = derived().calcMoveChangeBounded(*solution, distance, bound);
+		SA_STATS(stats.endEvaluation();)
+		if(change < 0 || change < maxChange){
+			if(change > 0) storePendingBest();
+			derived().commitMove(*solution);
+			distance += change;
+			return true;
+		}else{
+			derived().discardMove();
+			return false;
+		}
+	}else if(mode == IN_PLACE_NEIGHBOUR){
+		derived().applyRandomMove(*solution);
+		SA_STATS(stats.endGeneration();)
+		double newDistance = derived().calcDistanceToTargetBounded(*solution, distance+bound);
+		SA_STATS(stats.endEvaluation();)
+		assert(newDistance >= 0); // distances are always positive
+		double change = newDistance-distance;
+		if(change < 0 || change < maxChange){
+			distance = newDistance;
+			return true;
+		}else{
+			derived().undoMove(*solution);
+			return false;
+		}
+	}else{
+		Solution* newSolution = derived().giveRandomNeighbour(*solution);
+		SA_STATS(stats.endGeneration();)
+		double newDistance = derived().calcDistanceToTargetBounded(*newSolution, distance+bound);
+		SA_STATS(stats.endEvaluation();)
+		assert(newDistance >= 0); // distances are always positive
+		double change = newDistance-distance;
+		if(change < 0 || change < maxChange){
+			if(change > 0) storePendingBest();
+			allocator.release(solution);
+			solution = newSolution;
+			distance = newDistance;
+			return true;
+		}else{
+			allocator.release(newSolution);
+			return false;
+		}
+	}
+
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::solve(){
+
+	evaluateSolution();
+	derived().printStatus(*solution, temp);
+	while(!shouldStop(*solution, distance)){
+		step();
+		if(statusSampler.shouldSample(iteration)){
+			derived().printStatus(*solution, temp);
+		}
+		coolDown();
+		if(checkpointWriter != 0 && checkpointSampler.shouldSample(iteration)){
+			submitCheckpoint();
+		}
+	}
+	logSink->flush();
+	if(checkpointWriter != 0){
+		submitCheckpoint();
+		checkpointWriter->flush();
+	}
+	std::cout << "\n\n\n*************************************************************\n\n" 
+		<< "We're done, Solution: \n\n" << *solution << "\n\n*************************************************************\n" << std::endl;
+	if(SolverStats::ENABLED){
+		stats.print(std::cout);
+	}
+	
+	storePendingBest();
+	allocator.release(solution);
+	solution = 0;
+	delete TARGET;
+	TARGET = 0;
+
+	std::cout << "\n\n\nPress enter to continue..." << std::endl;
+
+	std::cin.get();
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+SolveResult<Solution> StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::solve(const SolveOptions& options){
+	beginSolve(options);
+	while(resume(LONG_MAX)){
+	}
+	return getResult();
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::beginSolve(const SolveOptions& options){
+	runOptions = options;
+	runStart = std::chrono::steady_clock::now();
+	runStartIteration = iteration;
+	runStartEvaluations = evaluations;
+	runKeptBest = keepBest;
+	running = true;
+
+	clockInterval = 1;
+	nextClockCheck = iteration;
+	lastClockCheck = runStart;
+
+	keepBest = true;
+	evaluateSolution();
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::resume(long maxIterations){
+	for(long i=0; running && i<maxIterations; i++){
+		if(shouldStopRun()){
+			running = false;
+			keepBest = runKeptBest;
+			break;
+		}
+		step();
+		coolDown();
+		if(checkpointWriter != 0 && checkpointSampler.shouldSample(iteration)){
+			submitCheckpoint();
+		}
+	}
+	return running;
+}
+
+//sets runStopReason when the search started by beginSolve() has to stop
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::shouldStopRun(){
+	if(distance < PRECISION){
+		runStopReason = STOP_PRECISION;
+	}else if(derived().shouldStopHook(*solution)){
+		runStopReason = STOP_HOOK;
+	}else if(runOptions.maxIterations >= 0 && iteration-runStartIteration >= runOptions.maxIterations){
+		runStopReason = STOP_ITERATIONS;
+	}else if(runOptions.maxEvaluations >= 0 && evaluations-runStartEvaluations >= runOptions.maxEvaluations){
+		runStopReason = STOP_EVALUATIONS;
+	}else if(runOptions.cancel != 0 && runOptions.cancel->load(std::memory_order_relaxed)){
+		runStopReason = STOP_CANCELLED;
+	}else if(iteration >= nextClockCheck){
+		//the interval adapts to the time an iteration takes so the deadline is checked about 
+		//every 50 microseconds
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if(now >= runOptions.deadline){
+			runStopReason = STOP_DEADLINE;
+			return true;
+		}
+		if(now-lastClockCheck < std::chrono::microseconds(50)){
+			if(clockInterval < 4096) clockInterval *= 2;
+		}else if(clockInterval > 1){
+			clockInterval /= 2;
+		}
+		lastClockCheck = now;
+		nextClockCheck = iteration+clockInterval;
+		return false;
+	}else{
+		return false;
+	}
+	return true;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+SolveResult<Solution> StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::getResult() const{
+	SolveResult<Solution> result;
+	storePendingBest();
+	if(bestSolution != 0){
+		result.bestSolution.reset(new Solution(*bestSolution));
+	}
+	result.bestDistance = bestDistance;
+	result.distance = distance;
+	result.stopReason = runStopReason;
+	result.iterations = iteration-runStartIteration;
+	result.evaluations = evaluations-runStartEvaluations;
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-runStart).count();
+	result.stats = stats;
+	return result;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::evaluateSolution(){
+	distance = derived().calcDistanceToTarget(*solution);
+	evaluations++;
+	SA_STATS(stats.recordStart(distance);)
+	if(keepBest){
+		updateBest();
+	}
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::coolDown(){
+	temp = derived().calcNewTemp(temp);
+	assert(temp >= 0); // only positive temperatures are allowed!
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+const Solution& StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::getSolution() const{
+	return *solution;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::getDistance() const{
+	return distance;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::getTemp() const{
+	return temp;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::setTemp(double temp){
+	assert(temp >= 0); // only positive temperatures are allowed!
+	this->temp = temp;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::reachedPrecision() const{
+	return distance < PRECISION;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::swapSolution(Derived& other){
+	storePendingBest();
+	other.storePendingBest();
+	Solution* hulpSolution = solution;
+	solution = other.solution;
+	other.solution = hulpSolution;
+
+	double hulpDistance = distance;
+	distance = other.distance;
+	other.distance = hulpDistance;
+
+	SA_STATS(stats.recordStart(distance);)
+	SA_STATS(other.stats.recordStart(other.distance);)
+	if(keepBest){
+		updateBest();
+	}
+	if(other.keepBest){
+		other.updateBest();
+	}
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::setCooling(const Cooling& cooling){
+	this->cooling = cooling;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::setAcceptance(const Acceptance& acceptance){
+	this->acceptance = acceptance;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+Cooling& StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::getCooling(){
+	return cooling;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+Acceptance& StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::getAcceptance(){
+	return acceptance;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+long StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::getIteration() const{
+	return iteration;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+long StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::getEvaluations() const{
+	return evaluations;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+const SolverStats& StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::getStats() const{
+	return stats;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::setLogSink(LogSink& sink){
+	logSink = &sink;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::setStatusInterval(long everyIterations, double everyMilliseconds){
+	statusSampler = StatusSampler(everyIterations, everyMilliseconds);
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::writeLog(const std::string& line) const{
+	logSink->write(line);
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::setKeepBest(bool keep){
+	keepBest = keep;
+	if(keepBest && solution != 0){
+		updateBest();
+	}
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+const Solution* StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::getBestSolution() const{
+	storePendingBest();
+	return bestSolution;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::getBestDistance() const{
+	return bestDistance;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::updateBest(){
+	if((bestSolution == 0 && !bestPending) || distance < bestDistance){
+		bestDistance = distance;
+		bestPending = true;
+		//an in-place move changes the solution before it is known whether it is accepted, 
+		//so there the copy can't wait
+		if(derived().getNeighbourMode() == IN_PLACE_NEIGHBOUR){
+			storePendingBest();
+		}
+	}
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::storePendingBest() const{
+	if(bestPending){
+		allocator.release(bestSolution);
+		bestSolution = allocator.copy(*solution);
+		bestPending = false;
+	}
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+inline Solution* StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::copySolution(const Solution& solution) const{
+	return allocator.copy(solution);
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::saveCheckpoint(CheckpointWriter& writer) const{
+	writer.write(CHECKPOINT_MAGIC);
+	writer.write(distance);
+	writer.write(temp);
+	writer.write(iteration);
+	writer.write(evaluations);
+	writer.write(lastAccepted);
+	writer.write(cooling);
+	writer.write(acceptance);
+	writer.write(rng);
+	writer.write(exponentials);
+	writer.write(stats);
+	writeCheckpoint(writer, *solution);
+
+	storePendingBest();
+	bool hasBest = bestSolution != 0;
+	writer.write(hasBest);
+	if(hasBest){
+		writer.write(bestDistance);
+		writeCheckpoint(writer, *bestSolution);
+	}
+
+	derived().writeProblemState(writer);
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::loadCheckpoint(CheckpointReader& reader){
+	uint32_t magic = 0;
+	if(!reader.read(magic) || magic != CHECKPOINT_MAGIC){
+		return false;
+	}
+	storePendingBest(); // the current solution is about to be overwritten
+	reader.read(distance);
+	reader.read(temp);
+	reader.read(iteration);
+	reader.read(evaluations);
+	reader.read(lastAccepted);
+	stepIterations = 1;
+	reader.read(cooling);
+	reader.read(acceptance);
+	reader.read(rng);
+	reader.read(exponentials);
+	reader.read(stats);
+	if(!reader.good() || !readCheckpoint(reader, *solution)){
+		return false;
+	}
+
+	bool hasBest = false;
+	reader.read(hasBest);
+	if(hasBest){
+		reader.read(bestDistance);
+		if(bestSolution == 0){
+			bestSolution = allocator.copy(*solution);
+		}
+		bestPending = false;
+		if(!reader.good() || !readCheckpoint(reader, *bestSolution)){
+			return false;
+		}
+	}
+
+	return reader.good() && derived().readProblemState(reader);
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::saveCheckpoint(const std::string& path) const{
+	CheckpointWriter writer;
+	saveCheckpoint(writer);
+	return writeCheckpointFile(path, writer.getBuffer());
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::loadCheckpoint(const std::string& path){
+	std::vector<char> buffer;
+	if(!readCheckpointFile(path, buffer)){
+		return false;
+	}
+	CheckpointReader reader(buffer);
+	return loadCheckpoint(reader);
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::setCheckpointFile(const std::string& path, long everyIterations, double everyMilliseconds){
+	delete checkpointWriter;
+	checkpointWriter = new AsyncCheckpointWriter(path);
+	checkpointSampler = StatusSampler(everyIterations, everyMilliseconds);
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::submitCheckpoint(){
+	CheckpointWriter writer;
+	saveCheckpoint(writer);
+	checkpointWriter->submit(writer.getBuffer());
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::writeProblemState(CheckpointWriter& writer) const{
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::readProblemState(CheckpointReader& reader){
+	return true;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::shouldStopHook(const Solution& solution){
+	return false;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::printStatus(const Solution& solution, double temp){
+	std::ostringstream line;
+	line << "Current solution: " << solution << " at Temp: " << temp;
+	writeLog(line.str());
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+typename StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::NeighbourMode StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::getNeighbourMode() const{
+	return COPY_NEIGHBOUR;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::proposeMove(const Solution& solution){
+	assert(false); // has to be hidden when getNeighbourMode() returns MOVE_NEIGHBOUR
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::calcMoveChange(const Solution& solution, double distance){
+	assert(false); // has to be hidden when getNeighbourMode() returns MOVE_NEIGHBOUR
+	return 0;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::commitMove(Solution& solution){
+	assert(false); // has to be hidden when getNeighbourMode() returns MOVE_NEIGHBOUR
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::discardMove(){
+	assert(false); // has to be hidden when getNeighbourMode() returns MOVE_NEIGHBOUR
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::applyRandomMove(Solution& solution){
+	assert(false); // has to be hidden when getNeighbourMode() returns IN_PLACE_NEIGHBOUR
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+void StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::undoMove(Solution& solution){
+	assert(false); // has to be hidden when getNeighbourMode() returns IN_PLACE_NEIGHBOUR
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::useMaxChangeAcceptance() const{
+	return false;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::calcMaxChange(double temp) const{
+	return acceptance.maxChange(distance, temp, exponentials.next(rng));
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::calcDistanceToTargetBounded(const Solution& solution, double maxDistance) const{
+	return derived().calcDistanceToTarget(solution);
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::calcMoveChangeBounded(const Solution& solution, double distance, double maxChange){
+	return derived().calcMoveChange(solution, distance);
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+bool StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::useRejectionFreeSteps() const{
+	return false;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+double StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::proposeRejectionFreeMove(const Solution& solution, double temp){
+	assert(false); // has to be hidden when useRejectionFreeSteps() returns true
+	return 0;
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+Derived& StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::derived(){
+	return static_cast<Derived&>(*this);
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+const Derived& StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::derived() const{
+	return static_cast<const Derived&>(*this);
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::StaticSimulatedAnnealing(const Solution& startSolution, const Target& target, 
+					double starttemp, double precision, double alpha, uint64_t seed):solution(allocator.copy(startSolution)),TARGET(new Target(target))
+					,distance(0),temp(starttemp),PRECISION(precision),ALPHA(alpha),START_TEMP(starttemp),iteration(0),evaluations(0),lastAccepted(false),stepIterations(1)
+					,cooling(alpha),rng(seed),logSink(&consoleLogSink()),keepBest(false),bestSolution(0),bestDistance(HUGE_VAL),bestPending(false)
+					,checkpointWriter(0),runStartIteration(0),runStartEvaluations(0),runKeptBest(false),running(false)
+					,runStopReason(STOP_PRECISION),clockInterval(1),nextClockCheck(0){
+	assert(starttemp >= 0); // only positive temperatures are allowed!
+}
+
+template <class Derived, class Solution, class Target, class RNG, class Cooling, class Acceptance, class Allocator>
+StaticSimulatedAnnealing<Derived,Solution,Target,RNG,Cooling,Acceptance,Allocator>::~StaticSimulatedAnnealing(){
+	delete checkpointWriter;
+	allocator.release(solution);
+	delete TARGET;
+	allocator.release(bestSolution);
+}
+
+
+
+#endif
\ No newline at end of file
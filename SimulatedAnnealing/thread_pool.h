@@ -0,0 +1,207 @@
+#ifndef __THREAD_POOL_H
+#define __THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+
+/***********************************************************************************************//**
+
+	\brief Fixed size, work-stealing pool of worker threads
+
+	Every worker has its own queue of tasks. Tasks submitted by a worker go to its own queue,
+	tasks submitted from outside the pool are spread over the queues round robin. A worker
+	takes the oldest task of its own queue first and, when that one is empty, steals the
+	newest task of another worker's queue, so no worker sits idle while there is work.
+	Taking the oldest task first keeps the pool fair for tasks that resubmit themselves
+	(e.g. the slices of the chains of MultiStart).
+
+	wait() blocks until every submitted task has finished, which is what the drivers built on
+	top of SimulatedAnnealing (e.g. ParallelTempering) use as barrier between rounds.
+
+***************************************************************************************************/
+
+class ThreadPool{
+
+public:
+
+	/**
+		Constructor
+			@param nThreads The number of worker threads, 0 uses one thread per hardware thread
+	*/
+	explicit ThreadPool(unsigned nThreads = 0);
+
+	/**
+		Finishes the tasks still in the queues and joins the workers
+	*/
+	~ThreadPool();
+
+	void submit(const std::function<void()>& task);
+
+	/**
+		Blocks until all submitted tasks have been executed
+	*/
+	void wait();
+
+	unsigned size() const;
+
+private:
+	struct WorkQueue{
+		std::mutex mutex;
+		std::deque<std::function<void()> > tasks;
+	};
+
+	std::vector<std::thread> workers;
+	std::vector<WorkQueue*> queues; // one per worker
+	std::mutex mutex; // guards the counters below
+	std::condition_variable taskAvailable;
+	std::condition_variable allDone;
+	unsigned queued; // number of tasks waiting in one of the queues
+	unsigned pending; // number of tasks submitted but not yet finished
+	unsigned nextQueue; // queue for the next task submitted from outside the pool
+	bool stopping;
+
+	void work(unsigned index);
+	bool takeTask(unsigned index, std::function<void()>& task);
+
+	//index of the worker of this pool that is running the calling thread, -1 if none
+	int currentWorker() const;
+	static ThreadPool*& currentPool();
+	static int& currentIndex();
+
+	ThreadPool(const ThreadPool&);
+	ThreadPool& operator=(const ThreadPool&);
+};
+
+inline ThreadPool::ThreadPool(unsigned nThreads):queued(0),pending(0),nextQueue(0),stopping(false){
+	if(nThreads == 0){
+		nThreads = std::thread::hardware_concurrency();
+		if(nThreads == 0) nThreads = 1;
+	}
+	for(unsigned i=0; i<nThreads; i++){
+		queues.push_back(new WorkQueue());
+	}
+	for(unsigned i=0; i<nThreads; i++){
+		workers.push_back(std::thread(&ThreadPool::work, this, i));
+	}
+}
+
+inline ThreadPool::~ThreadPool(){
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	taskAvailable.notify_all();
+	for(size_t i=0; i<workers.size(); i++){
+		workers[i].join();
+	}
+	for(size_t i=0; i<queues.size(); i++){
+		delete queues[i];
+	}
+}
+
+inline void ThreadPool::submit(const std::function<void()>& task){
+	unsigned index;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		int worker = currentWorker();
+		if(worker >= 0){
+			index = (unsigned)worker;
+		}else{
+			index = nextQueue;
+			nextQueue = (nextQueue+1)%queues.size();
+		}
+		// counted before it is queued, a worker that wakes up too early just looks again
+		queued++;
+		pending++;
+	}
+	{
+		std::unique_lock<std::mutex> lock(queues[index]->mutex);
+		queues[index]->tasks.push_back(task);
+	}
+	taskAvailable.notify_one();
+}
+
+inline void ThreadPool::wait(){
+	std::unique_lock<std::mutex> lock(mutex);
+	while(pending > 0){
+		allDone.wait(lock);
+	}
+}
+
+inline unsigned ThreadPool::size() const{
+	return (unsigned)workers.size();
+}
+
+inline bool ThreadPool::takeTask(unsigned index, std::function<void()>& task){
+	{
+		WorkQueue* own = queues[index];
+		std::unique_lock<std::mutex> lock(own->mutex);
+		if(!own->tasks.empty()){
+			task = own->tasks.front();
+			own->tasks.pop_front();
+			return true;
+		}
+	}
+	for(size_t i=1; i<queues.size(); i++){
+		WorkQueue* victim = queues[(index+i)%queues.size()];
+		std::unique_lock<std::mutex> lock(victim->mutex);
+		if(!victim->tasks.empty()){
+			task = victim->tasks.back();
+			victim->tasks.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+inline void ThreadPool::work(unsigned index){
+	currentPool() = this;
+	currentIndex() = (int)index;
+	while(true){
+		std::function<void()> task;
+		if(takeTask(index, task)){
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				queued--;
+			}
+
+			task();
+
+			std::unique_lock<std::mutex> lock(mutex);
+			pending--;
+			if(pending == 0){
+				allDone.notify_all();
+			}
+		}else{
+			std::unique_lock<std::mutex> lock(mutex);
+			while(queued == 0 && !stopping){
+				taskAvailable.wait(lock);
+			}
+			if(queued == 0){ // stopping and nothing left to do
+				return;
+			}
+		}
+	}
+}
+
+inline int ThreadPool::currentWorker() const{
+	return currentPool() == this ? currentIndex() : -1;
+}
+
+inline ThreadPool*& ThreadPool::currentPool(){
+	static thread_local ThreadPool* pool = 0;
+	return pool;
+}
+
+inline int& ThreadPool::currentIndex(){
+	static thread_local int index = -1;
+	return index;
+}
+
+#endif